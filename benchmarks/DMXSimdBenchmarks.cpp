@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <dmx_simd.hpp>
+#include <array>
+
+using namespace sACNcpp;
+
+/**
+ * @brief two equal universes, the worst case for comparing
+ * 
+ */
+struct EqualBuffers
+{
+    EqualBuffers()
+    {
+        for(uint16_t i = 0; i < 512; i++)
+            a[i] = b[i] = i * 7;
+    }
+
+    std::array<uint8_t, 512> a, b;
+};
+
+static void BM_EqualScalar(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(simd::scalar::equal(buffers.a.data(), buffers.b.data(), 512));
+}
+BENCHMARK(BM_EqualScalar);
+
+static void BM_EqualSimd(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(simd::equal(buffers.a.data(), buffers.b.data(), 512));
+}
+BENCHMARK(BM_EqualSimd);
+
+static void BM_DiffScalar(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    buffers.b[100]++;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(simd::scalar::diff(buffers.a.data(), buffers.b.data()));
+}
+BENCHMARK(BM_DiffScalar);
+
+static void BM_DiffSimd(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    buffers.b[100]++;
+    for(auto _ : state)
+        benchmark::DoNotOptimize(simd::diff(buffers.a.data(), buffers.b.data()));
+}
+BENCHMARK(BM_DiffSimd);
+
+/**
+ * @brief finding the changed range, as done when copying into a DMXUniverseData
+ * 
+ */
+static void BM_ChangedRangeScalar(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    buffers.b[256]++;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(simd::scalar::firstDifference(buffers.a.data(), buffers.b.data(), 512));
+        benchmark::DoNotOptimize(simd::scalar::lastDifference(buffers.a.data(), buffers.b.data(), 512));
+    }
+}
+BENCHMARK(BM_ChangedRangeScalar);
+
+static void BM_ChangedRangeSimd(benchmark::State& state)
+{
+    EqualBuffers buffers;
+    buffers.b[256]++;
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(simd::firstDifference(buffers.a.data(), buffers.b.data(), 512));
+        benchmark::DoNotOptimize(simd::lastDifference(buffers.a.data(), buffers.b.data(), 512));
+    }
+}
+BENCHMARK(BM_ChangedRangeSimd);
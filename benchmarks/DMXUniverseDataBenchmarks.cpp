@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+#include <dmx_universe_data.hpp>
+#include <array>
+
+using namespace sACNcpp;
+
+/**
+ * @brief shared between the threads of a benchmark
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static DMXUniverseData& sharedData()
+{
+    static DMXUniverseData data(Synchronization);
+    return data;
+}
+
+/**
+ * @brief thread 0 writes all 512 channels one set() at a time, like render code does, 
+ * all other threads take full snapshots, like the output thread does.
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataContention(benchmark::State& state)
+{
+    DMXUniverseData& data = sharedData<Synchronization>();
+    std::array<uint8_t, 512> snapshot;
+
+    for(auto _ : state)
+    {
+        if(state.thread_index() == 0)
+        {
+            for(uint16_t i = 0; i < 512; i++)
+                data.set(i, i);
+        }
+        else
+        {
+            data.write(snapshot.data(), 512);
+            benchmark::DoNotOptimize(snapshot);
+        }
+    }
+
+    if(state.thread_index() == 0)
+        state.counters["frames"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+    else
+        state.counters["snapshots"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataContention, DMXSynchronization::Mutex)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataContention, DMXSynchronization::SeqLock)->ThreadRange(1, 4)->UseRealTime();
+
+/**
+ * @brief writing a frame one set() per channel
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataSetFrame(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+
+    for(auto _ : state)
+    {
+        for(uint16_t i = 0; i < 512; i++)
+            data.set(i, i);
+    }
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataSetFrame, DMXSynchronization::Mutex);
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataSetFrame, DMXSynchronization::SeqLock);
+
+/**
+ * @brief writing a frame in one transaction
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataTransactionFrame(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+
+    for(auto _ : state)
+    {
+        auto tx = data.begin();
+        for(uint16_t i = 0; i < 512; i++)
+            tx[i] = i;
+        tx.commit();
+    }
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataTransactionFrame, DMXSynchronization::Mutex);
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataTransactionFrame, DMXSynchronization::SeqLock);
+
+/**
+ * @brief writing a frame with setRange()
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataSetRangeFrame(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+    std::array<uint8_t, 512> frame;
+    frame.fill(127);
+
+    for(auto _ : state)
+    {
+        data.setRange(0, frame.data(), 512);
+    }
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataSetRangeFrame, DMXSynchronization::Mutex);
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataSetRangeFrame, DMXSynchronization::SeqLock);
+
+/**
+ * @brief thread 0 writes all 512 channels one set() at a time, all other threads read: 
+ * state.range(0) == 0 reads every channel with operator[], 1 compares to another universe with operator==, 
+ * 2 copies the universe with operator=.
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataReadContention(benchmark::State& state)
+{
+    static DMXUniverseData data(Synchronization);
+    DMXUniverseData other(Synchronization);
+    uint32_t sum = 0;
+
+    for(auto _ : state)
+    {
+        if(state.thread_index() == 0)
+        {
+            for(uint16_t i = 0; i < 512; i++)
+                data.set(i, i);
+        }
+        else if(state.range(0) == 0)
+        {
+            for(uint16_t i = 0; i < 512; i++)
+                sum += data[i];
+        }
+        else if(state.range(0) == 1)
+        {
+            sum += data == other;
+        }
+        else
+        {
+            other = data;
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+
+    if(state.thread_index() != 0)
+        state.counters["reads"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataReadContention, DMXSynchronization::Mutex)->DenseRange(0, 2)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataReadContention, DMXSynchronization::SeqLock)->DenseRange(0, 2)->ThreadRange(1, 4)->UseRealTime();
+
+/**
+ * @brief writing and reading back a value spread over state.range(0) channels
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_DMXUniverseDataVariableResolution(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+    uint8_t resolution = state.range(0);
+    double value = 0;
+
+    for(auto _ : state)
+    {
+        value += 0.001;
+        if(value > 1)
+            value = 0;
+
+        data.writeVariableResolutionValue(value, 100, resolution);
+        benchmark::DoNotOptimize(data.readVariableResolutionValue(100, resolution));
+    }
+}
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataVariableResolution, DMXSynchronization::Mutex)->DenseRange(1, 4);
+BENCHMARK_TEMPLATE(BM_DMXUniverseDataVariableResolution, DMXSynchronization::SeqLock)->DenseRange(1, 4);
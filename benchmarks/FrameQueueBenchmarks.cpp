@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <sacn_frame_queue.hpp>
+#include <cstring>
+
+using namespace sACNcpp;
+
+/**
+ * @brief pushes a full 512 slot frame and pops it again, the cost per frame for the receiving and the consuming thread.
+ * state.range(0) selects the overflow policy: 0 drops the oldest, 1 the newest frame.
+ *
+ */
+static void BM_FrameQueuePushPop(benchmark::State& state)
+{
+    sACNOverflowPolicy policy = state.range(0) == 0 ? sACNOverflowPolicy::DropOldest : sACNOverflowPolicy::DropNewest;
+    sACNFrameQueue queue(256, policy);
+
+    std::array<uint8_t, 512> data{};
+    uint8_t sequence = 0;
+    sACNFrame frame;
+    for(auto _ : state)
+    {
+        queue.pushInPlace([&](sACNFrame& slot) {
+            slot.universe = 1;
+            slot.sequence = sequence++;
+            slot.slots = 512;
+            memcpy(slot.data.data(), data.data(), 512);
+        });
+        queue.pop(frame);
+        benchmark::DoNotOptimize(frame);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameQueuePushPop)->Arg(0)->Arg(1);
+
+/**
+ * @brief pushes frames to a full queue that drops the oldest frame, the worst case for the receiving thread
+ *
+ */
+static void BM_FrameQueueOverflow(benchmark::State& state)
+{
+    sACNFrameQueue queue(256, sACNOverflowPolicy::DropOldest);
+
+    std::array<uint8_t, 512> data{};
+    for(auto _ : state)
+    {
+        queue.pushInPlace([&](sACNFrame& slot) {
+            slot.slots = 512;
+            memcpy(slot.data.data(), data.data(), 512);
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FrameQueueOverflow);
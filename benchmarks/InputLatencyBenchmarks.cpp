@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+#include <sacn_input.hpp>
+#include <sacn_sender_socket.hpp>
+#include <chrono>
+#include <memory>
+
+using namespace sACNcpp;
+
+/**
+ * @brief measures the time from sending a packet on loopback until its data is visible in sACNInput
+ * 
+ * @param async true: receive with startAsync(), false: receive with the polling start()
+ */
+static void measureLatency(benchmark::State& state, bool async)
+{
+    Logger::setLogger(nullptr);
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNInput input(context);
+    sACNSenderSocket sender(context);
+
+    if(!(async ? input.startAsync() : input.start()) || !input.addUniverse(1) || !sender.start())
+    {
+        state.SkipWithError("Could not open sockets");
+        return;
+    }
+
+    sACNPacket packet(1);
+    DMXUniverseData& received = input[1]->dmx();
+    uint8_t value = 0;
+
+    for(auto _ : state)
+    {
+        value = value == 255 ? 1 : value + 1;
+        packet.setDMX(10, value);
+        packet.setSequenceNumber(value);
+
+        auto start = std::chrono::steady_clock::now();
+        sender.sendPacketUnicast(packet, "127.0.0.1");
+        while(received[10] != value) {}
+        auto end = std::chrono::steady_clock::now();
+
+        state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+    }
+
+    input.stop();
+}
+
+static void BM_InputLatencyPolling(benchmark::State& state)
+{
+    measureLatency(state, false);
+}
+BENCHMARK(BM_InputLatencyPolling)->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
+
+static void BM_InputLatencyAsync(benchmark::State& state)
+{
+    measureLatency(state, true);
+}
+BENCHMARK(BM_InputLatencyAsync)->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
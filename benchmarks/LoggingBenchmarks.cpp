@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+#include <async_logger.hpp>
+#include <sacn_input.hpp>
+#include <sacn_sender_socket.hpp>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief formats and writes entries on the logging thread like DefaultLogger, to a discarding stream
+ *
+ */
+class SynchronousLogger : public LogInterface
+{
+public:
+    void Log(LogLevel loglevel, std::string text) override
+    {
+        auto t = std::time(nullptr);
+        auto tm = *std::localtime(&t);
+        m_out << "[" << std::put_time(&tm, "%d-%m-%Y %H-%M-%S") << "][" << int(loglevel) << "] " << text << std::endl;
+    }
+
+private:
+    std::ostream m_out{nullptr};
+};
+
+/**
+ * @brief sets up the logging of a benchmark: 0 logs LogLevel::Info and up, 1 all levels to an AsyncLogger,
+ * 2 all levels to a SynchronousLogger. Both write to a discarding stream.
+ *
+ */
+static void setUpLogging(int64_t mode, AsyncLogger& asyncLogger, SynchronousLogger& synchronousLogger)
+{
+    Logger::setLogger(mode == 2 ? static_cast<LogInterface*>(&synchronousLogger) : &asyncLogger);
+    Logger::setLevel(mode == 0 ? LogLevel::Info : LogLevel::Debug);
+}
+
+/**
+ * @brief handling a packet with the debug entry sACNInput logs per packet, logging set up by setUpLogging(state.range(0))
+ *
+ */
+static void BM_PacketDebugLogging(benchmark::State& state)
+{
+    std::ostream discard(nullptr);
+    AsyncLogger logger(discard, 4096);
+    SynchronousLogger synchronousLogger;
+    setUpLogging(state.range(0), logger, synchronousLogger);
+
+    sACNUniverseInput input;
+    sACNPacket packet(1);
+    uint8_t sequence = 0;
+    auto now = std::chrono::steady_clock::now();
+    for(auto _ : state)
+    {
+        packet.setSequenceNumber(sequence++);
+        input.handleNewPacket(packet, now);
+        SACNCPP_LOG(LogLevel::Debug, "Universe " + std::to_string(packet.universe()) + " received new packet.");
+    }
+
+    Logger::setLogger(nullptr);
+    Logger::setLevel(LogLevel::Info);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["dropped"] = logger.dropped();
+}
+BENCHMARK(BM_PacketDebugLogging)->Arg(0)->Arg(1)->Arg(2);
+
+/**
+ * @brief sends packets for 16 universes on loopback as fast as possible, and counts the packets sACNInput
+ * accepts, logging set up by setUpLogging(state.range(0))
+ *
+ */
+static void BM_ReceiveDebugLogging(benchmark::State& state)
+{
+    std::ostream discard(nullptr);
+    AsyncLogger logger(discard, 4096);
+    SynchronousLogger synchronousLogger;
+    setUpLogging(state.range(0), logger, synchronousLogger);
+
+    const uint16_t universes = 16;
+    auto context = std::make_shared<asio::io_context>();
+    sACNInput input(context);
+
+    if(!input.startAsync())
+    {
+        Logger::setLogger(nullptr);
+        state.SkipWithError("Could not open sockets");
+        return;
+    }
+
+    for(uint16_t universe = 1; universe <= universes; universe++)
+        input.addUniverse(universe);
+
+    std::atomic_bool sending{true};
+    std::thread sender([&]() {
+        sACNSenderSocket socket(context);
+        if(!socket.start())
+            return;
+
+        std::vector<sACNPacket> packets;
+        for(uint16_t universe = 1; universe <= universes; universe++)
+            packets.emplace_back(universe);
+
+        std::vector<const sACNPacket*> batch;
+        for(const sACNPacket& packet : packets)
+            batch.push_back(&packet);
+
+        while(sending.load())
+        {
+            for(sACNPacket& packet : packets)
+                packet.setSequenceNumber(packet.sequenceNumber() + 1);
+            socket.sendPacketsMulticast(batch);
+        }
+    });
+
+    auto accepted = [&]() {
+        uint64_t result = 0;
+        for(uint16_t universe = 1; universe <= universes; universe++)
+            result += input[universe]->statistics().accepted;
+        return result;
+    };
+
+    uint64_t received = 0;
+    for(auto _ : state)
+    {
+        uint64_t before = accepted();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        received += accepted() - before;
+    }
+
+    sending.store(false);
+    sender.join();
+    input.stop();
+
+    Logger::setLogger(nullptr);
+    Logger::setLevel(LogLevel::Info);
+    state.counters["packets"] = benchmark::Counter(received, benchmark::Counter::kIsRate);
+    state.counters["dropped"] = logger.dropped();
+}
+BENCHMARK(BM_ReceiveDebugLogging)->Arg(0)->Arg(1)->Arg(2)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <sacn_universe_input.hpp>
+#include <dmx_simd.hpp>
+#include <array>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief handles packets of state.range(0) sources with the same priority sending one universe, round robin
+ * 
+ * @param mergeMode the merge mode of the universe
+ */
+static void handleSourcePackets(benchmark::State& state, DMXMergeMode mergeMode, bool perAddressPriority = false)
+{
+    sACNUniverseInput input(DMXSynchronization::Mutex, mergeMode);
+
+    std::vector<sACNPacket> packets(state.range(0));
+    for(size_t i = 0; i < packets.size(); i++)
+    {
+        sACNCID cid{};
+        cid[0] = i;
+        cid[1] = i >> 8;
+        packets[i].setCID(cid);
+        packets[i].setSourceName("source " + std::to_string(i));
+        for(uint16_t channel = 0; channel < 512; channel++)
+            packets[i].setDMX(channel, channel * 7 + i * 13);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    for(const sACNPacket& packet : packets)
+    {
+        if(perAddressPriority)
+        {
+            sACNPacket priorities = packet;
+            priorities.setStartCode(E131_START_CODE_PER_ADDRESS_PRIORITY);
+            priorities.setSequenceNumber(packet.sequenceNumber() - 1);
+            for(uint16_t channel = 0; channel < 512; channel++)
+                priorities.setDMX(channel, 100 + (channel + packet.dmx(0)) % 3);
+            input.handleNewPacket(priorities, now);
+        }
+        input.handleNewPacket(packet, now);
+    }
+
+    size_t next = 0;
+    for(auto _ : state)
+    {
+        packets[next].setSequenceNumber(packets[next].sequenceNumber() + 1);
+        input.handleNewPacket(packets[next], now);
+        next = next + 1 == packets.size() ? 0 : next + 1;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_MergeHTP(benchmark::State& state)
+{
+    handleSourcePackets(state, DMXMergeMode::HTP);
+}
+BENCHMARK(BM_MergeHTP)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_MergeLTP(benchmark::State& state)
+{
+    handleSourcePackets(state, DMXMergeMode::LTP);
+}
+BENCHMARK(BM_MergeLTP)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// the same sources, all sending per address priorities (start code 0xDD)
+static void BM_MergePerAddressPriority(benchmark::State& state)
+{
+    handleSourcePackets(state, DMXMergeMode::HTP, true);
+}
+BENCHMARK(BM_MergePerAddressPriority)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_MaximumScalar(benchmark::State& state)
+{
+    std::array<uint8_t, 512> a{}, b{};
+    b.fill(100);
+    for(auto _ : state)
+    {
+        simd::scalar::maximum(a.data(), b.data(), 512);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_MaximumScalar);
+
+static void BM_MaximumSimd(benchmark::State& state)
+{
+    std::array<uint8_t, 512> a{}, b{};
+    b.fill(100);
+    for(auto _ : state)
+    {
+        simd::maximum(a.data(), b.data(), 512);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_MaximumSimd);
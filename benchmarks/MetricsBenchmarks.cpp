@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <sacn_metrics.hpp>
+#include <sacn_universe_input.hpp>
+#include <sacn_universe_output.hpp>
+#include <memory>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief handling packets for 64 universes, with (state.range(0) == 1) and without counting the packets and bytes
+ *
+ */
+static void BM_ReceiveInstrumentation(benchmark::State& state)
+{
+    const uint16_t universes = 64;
+    bool instrumented = state.range(0) == 1;
+
+    sACNMetricsRegistry registry;
+    std::vector<std::unique_ptr<sACNUniverseInput>> inputs;
+    std::vector<sACNPacket> packets;
+    for(uint16_t universe = 1; universe <= universes; universe++)
+    {
+        inputs.push_back(std::make_unique<sACNUniverseInput>(DMXSynchronization::Mutex, DMXMergeMode::HTP, universe));
+        if(instrumented)
+            inputs.back()->setMetrics(&registry.universe(universe));
+        packets.emplace_back(universe);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    uint8_t sequence = 0;
+    uint8_t value = 0;
+    for(auto _ : state)
+    {
+        sequence++;
+        value++;
+        for(uint16_t i = 0; i < universes; i++)
+        {
+            sACNPacket& packet = packets[i];
+            packet.setSequenceNumber(sequence);
+            packet.setDMX(0, value);
+            inputs[i]->handleNewPacket(packet, now);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * universes);
+}
+BENCHMARK(BM_ReceiveInstrumentation)->Arg(0)->Arg(1);
+
+/**
+ * @brief preparing changed packets for 1000 universes, with (state.range(0) == 1) and without counting 
+ * the sends and bytes
+ *
+ */
+static void BM_SendInstrumentation(benchmark::State& state)
+{
+    const uint16_t universes = 1000;
+    bool instrumented = state.range(0) == 1;
+
+    sACNMetricsRegistry registry;
+    std::vector<std::unique_ptr<sACNUniverseOutput>> outputs;
+    for(uint16_t universe = 1; universe <= universes; universe++)
+    {
+        outputs.push_back(std::make_unique<sACNUniverseOutput>(universe));
+        if(instrumented)
+            outputs.back()->setMetrics(&registry.universe(universe));
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    uint8_t value = 0;
+    for(auto _ : state)
+    {
+        value++;
+        for(std::unique_ptr<sACNUniverseOutput>& output : outputs)
+        {
+            output->dmx().set(0, value);
+            const sACNPacket* packet = output->preparePacket(now);
+            if(instrumented && packet != nullptr)
+                output->metrics()->sent(packet->length());
+            benchmark::DoNotOptimize(packet);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * universes);
+}
+BENCHMARK(BM_SendInstrumentation)->Arg(0)->Arg(1);
@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <sacn_packet.hpp>
+#include <dmx_universe_data.hpp>
+
+using namespace sACNcpp;
+
+/**
+ * @brief constructing a packet with all headers
+ * 
+ */
+static void BM_PacketConstruction(benchmark::State& state)
+{
+    uint16_t universe = 1;
+    for(auto _ : state)
+    {
+        sACNPacket packet(universe);
+        benchmark::DoNotOptimize(packet);
+        universe = universe % 63999 + 1;
+    }
+}
+BENCHMARK(BM_PacketConstruction);
+
+/**
+ * @brief copying a packet, as the receive path did before packets were prepared in place
+ * 
+ */
+static void BM_PacketCopy(benchmark::State& state)
+{
+    sACNPacket source(1);
+    sACNPacket destination;
+    for(auto _ : state)
+    {
+        destination = source;
+        benchmark::DoNotOptimize(destination);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PacketCopy);
+
+/**
+ * @brief validating the headers of a received packet
+ * 
+ */
+static void BM_PacketValid(benchmark::State& state)
+{
+    sACNPacket packet(1);
+    for(auto _ : state)
+    {
+        benchmark::DoNotOptimize(packet.valid());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PacketValid);
+
+/**
+ * @brief copying the 512 slots of a packet to a DMXUniverseData
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_PacketGetDMXDataCopy(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+    sACNPacket packet(1);
+    uint8_t value = 0;
+    for(auto _ : state)
+    {
+        // changes every slot, so every slot is copied
+        packet.setDMX(0, value++);
+        for(uint16_t i = 1; i < 512; i += 64)
+            packet.setDMX(i, value);
+        packet.getDMXDataCopy(data);
+    }
+    state.SetBytesProcessed(state.iterations() * 512);
+}
+BENCHMARK_TEMPLATE(BM_PacketGetDMXDataCopy, DMXSynchronization::Mutex);
+BENCHMARK_TEMPLATE(BM_PacketGetDMXDataCopy, DMXSynchronization::SeqLock);
+
+/**
+ * @brief copying the 512 slots of a DMXUniverseData to a packet
+ * 
+ */
+template<DMXSynchronization Synchronization>
+static void BM_PacketSetDMXDataCopy(benchmark::State& state)
+{
+    DMXUniverseData data(Synchronization);
+    for(uint16_t i = 0; i < 512; i++)
+        data.set(i, i);
+
+    sACNPacket packet(1);
+    for(auto _ : state)
+    {
+        packet.setDMXDataCopy(data);
+        benchmark::DoNotOptimize(packet);
+    }
+    state.SetBytesProcessed(state.iterations() * 512);
+}
+BENCHMARK_TEMPLATE(BM_PacketSetDMXDataCopy, DMXSynchronization::Mutex);
+BENCHMARK_TEMPLATE(BM_PacketSetDMXDataCopy, DMXSynchronization::SeqLock);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <sacn_packet_view.hpp>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief a receive batch of 64 datagrams: data packets of 512 and 100 slots, synchronization packets, 
+ * and every 8th data packet cut short
+ * 
+ */
+struct ReceiveBatch
+{
+    std::vector<sACNPacket> packets;
+    std::vector<size_t> lengths;
+
+    ReceiveBatch()
+    {
+        for(uint16_t i = 0; i < 64; i++)
+        {
+            if(i % 16 == 15)
+                packets.push_back(sACNPacket::syncPacket(1));
+            else
+                packets.emplace_back(i + 1, i % 2 == 0 ? 512 : 100);
+
+            lengths.push_back(packets.back().length() - (i % 8 == 7 ? 10 : 0));
+        }
+    }
+};
+
+/**
+ * @brief validating a receive batch in place against the datagram lengths, in packets per second
+ * 
+ */
+static void BM_PacketViewParse(benchmark::State& state)
+{
+    ReceiveBatch batch;
+    for(auto _ : state)
+    {
+        size_t valid = 0;
+        for(size_t i = 0; i < batch.packets.size(); i++)
+        {
+            sACNPacketView view(batch.packets[i], batch.lengths[i]);
+            valid += view.valid() || view.validSync();
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations() * batch.packets.size());
+}
+BENCHMARK(BM_PacketViewParse);
+
+/**
+ * @brief the checks of sACNPacket, which ignore the datagram lengths, for comparison
+ * 
+ */
+static void BM_PacketValidBatch(benchmark::State& state)
+{
+    ReceiveBatch batch;
+    for(auto _ : state)
+    {
+        size_t valid = 0;
+        for(size_t i = 0; i < batch.packets.size(); i++)
+        {
+            const sACNPacket& packet = batch.packets[i];
+            valid += packet.isSyncPacket() ? packet.validSync() : packet.valid();
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations() * batch.packets.size());
+}
+BENCHMARK(BM_PacketValidBatch);
+
+/**
+ * @brief validating a receive batch and copying the slots of the data packets to a universe, in packets per second
+ * 
+ */
+static void BM_PacketViewParseAndCopy(benchmark::State& state)
+{
+    ReceiveBatch batch;
+    DMXUniverseData data(DMXSynchronization::SeqLock);
+    for(auto _ : state)
+    {
+        for(size_t i = 0; i < batch.packets.size(); i++)
+        {
+            sACNPacketView view(batch.packets[i], batch.lengths[i]);
+            view.getDMXDataCopy(data);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch.packets.size());
+}
+BENCHMARK(BM_PacketViewParseAndCopy);
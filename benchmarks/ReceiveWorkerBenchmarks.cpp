@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <sacn_input.hpp>
+#include <sacn_sender_socket.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief sends packets for 16 universes on loopback as fast as possible from 4 threads, and counts the 
+ * packets sACNInput accepts with state.range(0) receive workers
+ * 
+ */
+static void BM_ReceiveWorkers(benchmark::State& state)
+{
+    Logger::setLogger(nullptr);
+
+    const uint16_t universes = 16;
+    const size_t senders = 4;
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNInput input(context, 64, state.range(0));
+
+    if(!input.startAsync())
+    {
+        state.SkipWithError("Could not open sockets");
+        return;
+    }
+
+    for(uint16_t universe = 1; universe <= universes; universe++)
+        input.addUniverse(universe);
+
+    std::atomic_bool sending{true};
+    std::vector<std::thread> threads;
+    for(size_t s = 0; s < senders; s++)
+    {
+        threads.emplace_back([&, s]() {
+            sACNSenderSocket sender(context);
+            if(!sender.start())
+                return;
+
+            // every sender owns a quarter of the universes, so sequence numbers stay consecutive
+            std::vector<sACNPacket> packets;
+            for(uint16_t universe = 1 + s; universe <= universes; universe += senders)
+                packets.emplace_back(universe);
+
+            std::vector<const sACNPacket*> batch;
+            for(const sACNPacket& packet : packets)
+                batch.push_back(&packet);
+
+            while(sending.load())
+            {
+                for(sACNPacket& packet : packets)
+                    packet.setSequenceNumber(packet.sequenceNumber() + 1);
+                sender.sendPacketsMulticast(batch);
+            }
+        });
+    }
+
+    auto accepted = [&]() {
+        uint64_t result = 0;
+        for(uint16_t universe = 1; universe <= universes; universe++)
+            result += input[universe]->statistics().accepted;
+        return result;
+    };
+
+    uint64_t received = 0;
+    for(auto _ : state)
+    {
+        uint64_t before = accepted();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        received += accepted() - before;
+    }
+
+    sending.store(false);
+    for(std::thread& thread : threads)
+        thread.join();
+    input.stop();
+
+    state.counters["packets"] = benchmark::Counter(received, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ReceiveWorkers)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include <sacn_sender_socket.hpp>
+#include <memory>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief creates one packet per universe, for universes 1 to count
+ * 
+ */
+static std::vector<std::unique_ptr<sACNPacket>> makePackets(size_t count)
+{
+    std::vector<std::unique_ptr<sACNPacket>> packets;
+    for(size_t i = 0; i < count; i++)
+        packets.emplace_back(new sACNPacket(i + 1));
+    return packets;
+}
+
+/**
+ * @brief one send_to syscall per universe, as sACNOutput did before batching
+ * 
+ */
+static void BM_SendPacketMulticast(benchmark::State& state)
+{
+    Logger::setLogger(nullptr);
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNSenderSocket socket(context, "127.0.0.1");
+    if(!socket.start())
+    {
+        state.SkipWithError("Could not open socket");
+        return;
+    }
+
+    auto packets = makePackets(state.range(0));
+    size_t syscalls = 0;
+
+    for(auto _ : state)
+    {
+        for(auto& packet : packets)
+            socket.sendPacketMulticast(*packet);
+        syscalls += packets.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * packets.size());
+    state.counters["syscalls"] = benchmark::Counter(syscalls, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SendPacketMulticast)->Arg(64)->Arg(512)->Arg(2048)->UseRealTime();
+
+/**
+ * @brief all universes of one pass handed to the kernel with sendmmsg
+ * 
+ */
+static void BM_SendPacketsMulticast(benchmark::State& state)
+{
+    Logger::setLogger(nullptr);
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNSenderSocket socket(context, "127.0.0.1");
+    if(!socket.start())
+    {
+        state.SkipWithError("Could not open socket");
+        return;
+    }
+
+    auto packets = makePackets(state.range(0));
+    std::vector<const sACNPacket*> batch;
+    for(auto& packet : packets)
+        batch.push_back(packet.get());
+
+    size_t syscalls = 0;
+
+    for(auto _ : state)
+    {
+        auto result = socket.sendPacketsMulticast(batch);
+        if(!result.failed.empty())
+        {
+            state.SkipWithError("Sending failed");
+            break;
+        }
+        syscalls += (batch.size() + 1023) / 1024;
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch.size());
+    state.counters["syscalls"] = benchmark::Counter(syscalls, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SendPacketsMulticast)->Arg(64)->Arg(512)->Arg(2048)->UseRealTime();
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <sacn_output.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace sACNcpp;
+
+/**
+ * @brief sends 2000 universes at 1000 frames per second with state.range(0) send workers, every universe
+ * is refreshed in every frame. Counts the packets sent and the frame deadlines missed by the workers.
+ *
+ */
+static void BM_SendWorkers(benchmark::State& state)
+{
+    Logger::setLogger(nullptr);
+
+    const uint16_t universes = 2000;
+    const double frameRate = 1000;
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNOutput output(context, frameRate, frameRate, state.range(0));
+
+    for(uint16_t universe = 1; universe <= universes; universe++)
+        output.addUniverse(universe);
+
+    if(!output.start())
+    {
+        state.SkipWithError("Could not open sockets");
+        return;
+    }
+
+    auto missedDeadlines = [&]() {
+        uint64_t result = 0;
+        for(size_t worker = 0; worker < output.sendWorkers(); worker++)
+            result += output.frameMetrics(worker).missedDeadlines;
+        return result;
+    };
+
+    uint64_t sent = 0;
+    uint64_t missed = 0;
+    for(auto _ : state)
+    {
+        uint64_t sentBefore = output.packetsSent();
+        uint64_t missedBefore = missedDeadlines();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        sent += output.packetsSent() - sentBefore;
+        missed += missedDeadlines() - missedBefore;
+    }
+
+    output.stop();
+
+    state.counters["packets"] = benchmark::Counter(sent, benchmark::Counter::kIsRate);
+    state.counters["missed"] = benchmark::Counter(missed, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SendWorkers)->Arg(1)->Arg(2)->Arg(4)->Iterations(5)->UseRealTime()->Unit(benchmark::kMillisecond);
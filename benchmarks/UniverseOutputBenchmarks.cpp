@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <sacn_universe_output.hpp>
+#include <memory>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief one pass of the sending thread over many universes, of which only every 100th changed
+ * 
+ */
+static void BM_GetNewPacketDataMostlyStatic(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<sACNUniverseOutput>> universes;
+    for(int64_t i = 0; i < state.range(0); i++)
+        universes.emplace_back(new sACNUniverseOutput(i + 1));
+
+    sACNPacket packet;
+    auto now = std::chrono::steady_clock::now();
+
+    // the first pass sends everything
+    for(auto& universe : universes)
+        universe->getNewPacketData(packet, now);
+
+    uint8_t value = 0;
+    size_t sent = 0;
+
+    for(auto _ : state)
+    {
+        value++;
+        for(size_t i = 0; i < universes.size(); i += 100)
+            universes[i]->dmx().set(1, value);
+
+        for(auto& universe : universes)
+            sent += universe->getNewPacketData(packet, now);
+    }
+
+    state.SetItemsProcessed(state.iterations() * universes.size());
+    state.counters["sent"] = benchmark::Counter(sent, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_GetNewPacketDataMostlyStatic)->Arg(3000);
+
+/**
+ * @brief one pass of the sending thread over state.range(0) universes, which all changed
+ * 
+ */
+static void BM_GetNewPacketDataAllChanged(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<sACNUniverseOutput>> universes;
+    for(int64_t i = 0; i < state.range(0); i++)
+        universes.emplace_back(new sACNUniverseOutput(i + 1));
+
+    sACNPacket packet;
+    auto now = std::chrono::steady_clock::now();
+    uint8_t value = 0;
+
+    for(auto _ : state)
+    {
+        value++;
+        for(auto& universe : universes)
+            universe->dmx().set(1, value);
+
+        for(auto& universe : universes)
+            benchmark::DoNotOptimize(universe->getNewPacketData(packet, now));
+    }
+
+    state.SetItemsProcessed(state.iterations() * universes.size());
+}
+BENCHMARK(BM_GetNewPacketDataAllChanged)->Arg(1)->Arg(100)->Arg(3000);
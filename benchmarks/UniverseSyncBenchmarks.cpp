@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <sacn_input.hpp>
+#include <sacn_output.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+using namespace sACNcpp;
+
+/**
+ * @brief sends frames to several universes on loopback and measures the time between the first and the 
+ * last universe of a frame becoming visible in sACNInput
+ * 
+ * @param synchronized true: the universes are sent with a synchronization address
+ */
+static void measurePublishSpread(benchmark::State& state, bool synchronized)
+{
+    Logger::setLogger(nullptr);
+
+    const uint16_t universes = state.range(0);
+    const uint16_t syncAddress = 1000;
+
+    auto context = std::make_shared<asio::io_context>();
+    sACNInput input(context);
+    sACNOutput output(nullptr, 5, 1000);
+
+    if(!input.startAsync() || !output.start())
+    {
+        state.SkipWithError("Could not open sockets");
+        return;
+    }
+
+    for(uint16_t universe = 1; universe <= universes; universe++)
+    {
+        input.addUniverse(universe);
+        output.addUniverse(universe);
+        if(synchronized)
+            output.setSyncAddress(universe, syncAddress);
+    }
+
+    uint8_t value = 0;
+    double totalSpread = 0;
+
+    for(auto _ : state)
+    {
+        value = value == 255 ? 1 : value + 1;
+        for(uint16_t universe = 1; universe <= universes; universe++)
+            output[universe]->dmx().set(10, value);
+
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        auto first = std::chrono::steady_clock::time_point::max();
+        auto last = std::chrono::steady_clock::time_point::min();
+
+        for(uint16_t universe = 1; universe <= universes; universe++)
+        {
+            while(input[universe]->dmx()[10] != value && std::chrono::steady_clock::now() < timeout) {}
+
+            first = std::min(first, input[universe]->lastPublished());
+            last = std::max(last, input[universe]->lastPublished());
+        }
+
+        if(std::chrono::steady_clock::now() >= timeout)
+        {
+            state.SkipWithError("Frame not received");
+            break;
+        }
+
+        double spread = std::chrono::duration<double>(last - first).count();
+        totalSpread += spread;
+        state.SetIterationTime(spread);
+    }
+
+    state.counters["spread_us"] = benchmark::Counter(totalSpread * 1e6 / state.iterations());
+
+    output.stop();
+    input.stop();
+}
+
+static void BM_PublishSpreadUnsynchronized(benchmark::State& state)
+{
+    measurePublishSpread(state, false);
+}
+BENCHMARK(BM_PublishSpreadUnsynchronized)->Arg(16)->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
+
+static void BM_PublishSpreadSynchronized(benchmark::State& state)
+{
+    measurePublishSpread(state, true);
+}
+BENCHMARK(BM_PublishSpreadSynchronized)->Arg(16)->UseManualTime()->Iterations(200)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <sacn_universe_table.hpp>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <random>
+#include <vector>
+
+using namespace sACNcpp;
+
+static std::vector<uint16_t> lookupUniverses(int universes)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(1, universes);
+
+    std::vector<uint16_t> result(4096);
+    for(uint16_t& universe : result)
+        universe = distribution(generator);
+    return result;
+}
+
+// the previous lookup: a std::map guarded by a shared_timed_mutex
+static void BM_UniverseLookupMap(benchmark::State& state)
+{
+    std::map<uint16_t, int*> universes;
+    std::shared_timed_mutex mutex;
+    std::vector<int> values(state.range(0) + 1);
+    for(int universe = 1; universe <= state.range(0); universe++)
+        universes.emplace(universe, &values[universe]);
+
+    std::vector<uint16_t> lookups = lookupUniverses(state.range(0));
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        std::shared_lock<std::shared_timed_mutex> readLock(mutex);
+        auto it = universes.find(lookups[i++ & 4095]);
+        benchmark::DoNotOptimize(it->second);
+    }
+}
+BENCHMARK(BM_UniverseLookupMap)->Arg(10)->Arg(10000);
+
+static void BM_UniverseLookupTable(benchmark::State& state)
+{
+    sACNUniverseTable<int> universes;
+    for(int universe = 1; universe <= state.range(0); universe++)
+        universes.insert(universe, std::make_unique<int>(universe));
+
+    std::vector<uint16_t> lookups = lookupUniverses(state.range(0));
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(universes.find(lookups[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_UniverseLookupTable)->Arg(10)->Arg(10000);
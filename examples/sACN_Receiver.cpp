@@ -2,6 +2,7 @@
 #include <asio_standalone_or_boost.hpp>
 #include <thread>
 #include <chrono>
+#include <iostream>
 
 int main()
 {
@@ -16,9 +17,19 @@ int main()
     if(!input.addUniverse(2))
         exit(1);
 
+    // only the channels that changed are printed
+    for(uint16_t universe = 1; universe <= 2; universe++)
+    {
+        input.subscribe(universe, [&input](const sACNcpp::DMXChangeEvent& event) {
+            sACNcpp::DMXUniverseData& dmx = input[event.universe]->dmx();
+            event.changed.forEach([&](uint16_t channel) {
+                std::cout << "Universe " << event.universe << " channel " << channel + 1 << ": " << int(dmx[channel]) << std::endl;
+            });
+        });
+    }
+
     while(1)
     {
-        //input[1]->dmx().print();
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <sacn_packet_view.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace sACNcpp;
+
+/**
+ * @brief libFuzzer entry point: parses the input as a received datagram, in place and in a reused
+ * receive buffer. Every accessor of a valid view has to stay within the datagram, which AddressSanitizer checks
+ * as the input is allocated with its exact size.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    sACNPacketView view(data, size);
+
+    if(view.valid())
+    {
+        const uint8_t* slots = view.slotData();
+        if(view.numDMXSlots() > 512 || slots + view.numDMXSlots() > data + size)
+            abort();
+
+        DMXUniverseData universe;
+        view.getDMXDataCopy(universe);
+        for(uint16_t i = 0; i < view.numDMXSlots(); i++)
+        {
+            if(universe[i] != slots[i])
+                abort();
+        }
+
+        volatile size_t sink = view.sourceName().size() + view.universe() + view.priority() + view.options() +
+            view.startCode() + view.syncAddress() + view.sequenceNumber() + view.cid()[0];
+        (void)sink;
+    }
+    else if(view.validSync())
+    {
+        volatile size_t sink = view.syncAddress() + view.sequenceNumber() + view.cid()[0];
+        (void)sink;
+    }
+
+    // a receive buffer still holding a complete packet, overwritten by the input like by a short datagram
+    sACNPacket buffer(1, 512);
+    size_t length = std::min(size, sizeof(buffer.getPackedPacket()->raw));
+    memcpy(buffer.getPackedPacket()->raw, data, length);
+
+    sACNPacketView received(buffer, length);
+    if(received.valid() != view.valid() && size <= length)
+        abort();
+
+    // the accessors of the packet itself have to stay within its buffer, whatever the length fields say
+    DMXUniverseData copy;
+    buffer.getDMXDataCopy(copy);
+
+    return 0;
+}
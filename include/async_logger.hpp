@@ -0,0 +1,257 @@
+#pragma once
+#include <logger.hpp>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace sACNcpp
+{
+    /**
+     * @brief A logger moving the formatting and writing of entries to a background thread.
+     *
+     * Log() copies the text into a fixed capacity ring buffer and returns, it never blocks, allocates or
+     * does I/O. Several threads may log at once, the ring buffer is a bounded lock-free queue with a sequence
+     * number per entry. If the ring buffer is full, the entry is dropped and counted by dropped().
+     * Texts longer than the entries are truncated.
+     * A background thread drains the ring buffer, formats the entries like DefaultLogger and writes them to
+     * an ostream, flushing it whenever the ring buffer runs empty.
+     */
+    class AsyncLogger : public LogInterface
+    {
+        public:
+
+            /**
+             * @brief Construct a new AsyncLogger object and starts the background thread
+             *
+             * @param out the stream to write to, has to outlive the logger
+             * @param capacity the number of entries buffered, rounded up to a power of two
+             * @throw std::invalid_argument if capacity is 0
+             */
+            AsyncLogger(std::ostream& out = std::cout, size_t capacity = 1024) :
+                m_out(out)
+            {
+                if(capacity == 0)
+                    throw std::invalid_argument("The capacity of the logger has to be greater than 0.");
+
+                size_t size = 1;
+                while(size < capacity)
+                    size *= 2;
+
+                m_entries = std::vector<Entry>(size);
+                for(size_t i = 0; i < size; i++)
+                    m_entries[i].sequence.store(i, std::memory_order_relaxed);
+                m_mask = size - 1;
+
+                m_thread = std::thread([this]() { this->run(); });
+            }
+
+            AsyncLogger(const AsyncLogger&) = delete;
+            AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+            /**
+             * @brief Destroy the AsyncLogger object, after writing all entries logged before
+             *
+             */
+            ~AsyncLogger()
+            {
+                m_running.store(false);
+                m_thread.join();
+            }
+
+            /**
+             * @brief Queues an entry to be written by the background thread
+             *
+             * @param loglevel loglevel of the entry
+             * @param text text of the entry
+             */
+            void Log(LogLevel loglevel, std::string text) override
+            {
+                size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+                Entry* entry;
+                while(true)
+                {
+                    entry = &m_entries[position & m_mask];
+                    size_t sequence = entry->sequence.load(std::memory_order_acquire);
+                    intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+                    if(difference == 0)
+                    {
+                        if(m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                            break;
+                    }
+                    else if(difference < 0)
+                    {
+                        // the entry still holds an entry of the previous round, the ring buffer is full
+                        m_dropped.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    else
+                    {
+                        position = m_enqueuePosition.load(std::memory_order_relaxed);
+                    }
+                }
+
+                entry->level = loglevel;
+                entry->time = std::chrono::system_clock::now();
+                entry->length = std::min(text.size(), sizeof(entry->text));
+                memcpy(entry->text, text.data(), entry->length);
+                entry->sequence.store(position + 1, std::memory_order_release);
+            }
+
+            /**
+             * @brief Waits until all entries logged before were written and the stream was flushed
+             *
+             */
+            void flush()
+            {
+                size_t target = m_enqueuePosition.load(std::memory_order_acquire);
+                while(m_written.load(std::memory_order_acquire) < target)
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+
+            /**
+             * @brief the number of entries dropped because the ring buffer was full
+             *
+             */
+            uint64_t dropped() const
+            {
+                return m_dropped.load(std::memory_order_relaxed);
+            }
+
+        private:
+
+            /**
+             * @brief An entry of the ring buffer
+             *
+             */
+            struct Entry
+            {
+                /**
+                 * @brief equals the position of the next write to this entry while it is free,
+                 * and that position + 1 while it holds an entry to write
+                 *
+                 */
+                std::atomic<size_t> sequence{0};
+
+                LogLevel level = LogLevel::Debug;
+                std::chrono::system_clock::time_point time;
+                size_t length = 0;
+                char text[232];
+            };
+
+            /**
+             * @brief Executes the background thread: writes entries until the logger is destroyed and the ring buffer is empty
+             *
+             */
+            void run()
+            {
+                size_t position = 0;
+                while(true)
+                {
+                    Entry& entry = m_entries[position & m_mask];
+                    if(entry.sequence.load(std::memory_order_acquire) == position + 1)
+                    {
+                        write(entry);
+                        entry.sequence.store(position + m_mask + 1, std::memory_order_release);
+                        position++;
+                        continue;
+                    }
+
+                    m_out.flush();
+                    m_written.store(position, std::memory_order_release);
+
+                    if(!m_running.load() && m_enqueuePosition.load(std::memory_order_acquire) == position)
+                        return;
+
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+
+            /**
+             * @brief Formats an entry to the stream
+             *
+             */
+            void write(const Entry& entry)
+            {
+                const char* leveltext = "";
+                switch(entry.level)
+                {
+                    case LogLevel::Debug:
+                        leveltext = "Debug";
+                        break;
+                    case LogLevel::Info:
+                        leveltext = "Info";
+                        break;
+                    case LogLevel::Warning:
+                        leveltext = "Warning";
+                        break;
+                    case LogLevel::Critical:
+                        leveltext = "Critical";
+                        break;
+                }
+
+                std::time_t t = std::chrono::system_clock::to_time_t(entry.time);
+                std::tm tm = *std::localtime(&t);
+
+                m_out << "[" << std::put_time(&tm, "%d-%m-%Y %H-%M-%S") << "][" << leveltext << "] ";
+                m_out.write(entry.text, entry.length);
+                m_out << '\n';
+            }
+
+            /**
+             * @brief the stream entries are written to
+             *
+             */
+            std::ostream& m_out;
+
+            /**
+             * @brief the ring buffer
+             *
+             */
+            std::vector<Entry> m_entries;
+
+            /**
+             * @brief the number of entries - 1, to map positions to m_entries
+             *
+             */
+            size_t m_mask;
+
+            /**
+             * @brief the position of the next entry logged
+             *
+             */
+            std::atomic<size_t> m_enqueuePosition{0};
+
+            /**
+             * @brief the number of entries written and flushed
+             *
+             */
+            std::atomic<size_t> m_written{0};
+
+            /**
+             * @brief the number of entries dropped
+             *
+             */
+            std::atomic<uint64_t> m_dropped{0};
+
+            /**
+             * @brief false when the background thread should stop after writing all entries
+             *
+             */
+            std::atomic<bool> m_running{true};
+
+            /**
+             * @brief the background thread
+             *
+             */
+            std::thread m_thread;
+    };
+}
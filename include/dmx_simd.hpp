@@ -0,0 +1,507 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <array>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SACNCPP_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SACNCPP_SIMD_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sACNcpp {
+
+/**
+ * @brief A bitmap with one bit per DMX channel, e.g. marking the channels that changed.
+ * Bit (channel % 64) of words[channel / 64] represents channel.
+ *
+ */
+struct DMXChannelMask
+{
+    /**
+     * @brief the bits of all 512 channels
+     *
+     */
+    std::array<uint64_t, 8> words{};
+
+    /**
+     * @brief returns if the bit of a channel is set
+     *
+     */
+    bool test(uint16_t channel) const
+    {
+        return (words[channel / 64] >> (channel % 64)) & 1;
+    }
+
+    /**
+     * @brief sets the bit of a channel
+     *
+     */
+    void set(uint16_t channel)
+    {
+        words[channel / 64] |= uint64_t(1) << (channel % 64);
+    }
+
+    /**
+     * @brief returns if any bit is set
+     *
+     */
+    bool any() const
+    {
+        uint64_t result = 0;
+        for(uint64_t word : words)
+            result |= word;
+        return result != 0;
+    }
+
+    /**
+     * @brief returns the number of bits set
+     *
+     */
+    size_t count() const
+    {
+        size_t result = 0;
+        for(uint64_t word : words)
+        {
+#ifdef _MSC_VER
+            result += __popcnt64(word);
+#else
+            result += __builtin_popcountll(word);
+#endif
+        }
+        return result;
+    }
+
+    /**
+     * @brief clears the bits of all channels from count on
+     *
+     */
+    void truncate(uint16_t count)
+    {
+        for(uint16_t word = 0; word < 8; word++)
+        {
+            if(count <= word * 64)
+                words[word] = 0;
+            else if(count < (word + 1) * 64)
+                words[word] &= (uint64_t(1) << (count % 64)) - 1;
+        }
+    }
+
+    /**
+     * @brief calls f(channel) for every channel with its bit set, in ascending order
+     *
+     */
+    template<typename F>
+    void forEach(F&& f) const
+    {
+        for(uint16_t word = 0; word < 8; word++)
+        {
+            uint64_t bits = words[word];
+            while(bits)
+            {
+#ifdef _MSC_VER
+                unsigned long bit;
+                _BitScanForward64(&bit, bits);
+#else
+                unsigned bit = __builtin_ctzll(bits);
+#endif
+                f(uint16_t(word * 64 + bit));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    bool operator==(const DMXChannelMask& other) const
+    {
+        return words == other.words;
+    }
+
+    bool operator!=(const DMXChannelMask& other) const
+    {
+        return words != other.words;
+    }
+};
+
+/**
+ * @brief Kernels comparing and combining DMX channel buffers.
+ *
+ * The functions in this namespace use the widest instruction set enabled at compile time
+ * (AVX2 with -mavx2 or -march=native, otherwise SSE2 on x86), the same functions in
+ * simd::scalar are plain loops, used as fallback and as reference.
+ *
+ */
+namespace simd {
+
+/**
+ * @brief index of the lowest set bit, mask must not be 0
+ *
+ */
+inline unsigned lowestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * @brief index of the highest set bit, mask must not be 0
+ *
+ */
+inline unsigned highestBit(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+namespace scalar {
+
+/**
+ * @brief returns if the first length bytes of a and b are equal
+ *
+ */
+inline bool equal(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    for(size_t i = 0; i < length; i++)
+    {
+        if(a[i] != b[i])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief returns the index of the first byte differing between a and b, or length if they are equal
+ *
+ */
+inline size_t firstDifference(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    size_t i = 0;
+    while(i < length && a[i] == b[i])
+        i++;
+    return i;
+}
+
+/**
+ * @brief returns one past the index of the last byte differing between a and b, or 0 if they are equal
+ *
+ */
+inline size_t lastDifference(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    size_t i = length;
+    while(i > 0 && a[i-1] == b[i-1])
+        i--;
+    return i;
+}
+
+/**
+ * @brief returns the mask of all channels differing between the 512 channels in a and b
+ *
+ */
+inline DMXChannelMask diff(const uint8_t * a, const uint8_t * b)
+{
+    DMXChannelMask result;
+    for(uint16_t i = 0; i < 512; i++)
+    {
+        if(a[i] != b[i])
+            result.set(i);
+    }
+    return result;
+}
+
+/**
+ * @brief highest takes precedence merge: sets each of the first length bytes of destination to the maximum of itself and source
+ *
+ */
+inline void maximum(uint8_t * destination, const uint8_t * source, size_t length)
+{
+    for(size_t i = 0; i < length; i++)
+    {
+        if(source[i] > destination[i])
+            destination[i] = source[i];
+    }
+}
+
+/**
+ * @brief per slot priority merge: merges the levels and priorities of a source into the current winners.
+ * Slots where the source has a higher priority take its level, slots with the same priority take the 
+ * maximum (HTP) or the source level (LTP). Slots with source priority 0 are not driven by the source.
+ *
+ * @param levels the winning levels so far, updated
+ * @param priorities the winning priorities so far, updated
+ * @param sourceLevels the levels of the source
+ * @param sourcePriorities the priorities of the source
+ * @param length number of slots
+ * @param highestTakesPrecedence true: HTP for equal priorities, false: LTP
+ */
+inline void priorityMerge(uint8_t * levels, uint8_t * priorities, 
+    const uint8_t * sourceLevels, const uint8_t * sourcePriorities, size_t length, bool highestTakesPrecedence)
+{
+    for(size_t i = 0; i < length; i++)
+    {
+        uint8_t priority = sourcePriorities[i];
+        if(priority == 0 || priority < priorities[i])
+            continue;
+
+        if(priority > priorities[i] || !highestTakesPrecedence)
+            levels[i] = sourceLevels[i];
+        else if(sourceLevels[i] > levels[i])
+            levels[i] = sourceLevels[i];
+
+        priorities[i] = priority;
+    }
+}
+
+}
+
+#if defined(SACNCPP_SIMD_AVX2)
+
+/**
+ * @brief bit i is set if byte i differs between the 32 bytes at a and b
+ *
+ */
+inline uint32_t differenceMask(const uint8_t * a, const uint8_t * b)
+{
+    __m256i va = _mm256_loadu_si256((const __m256i*)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+    return ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+}
+
+/**
+ * @brief stores the bytewise maximum of the 32 bytes at destination and source to destination
+ *
+ */
+inline void vectorMaximum(uint8_t * destination, const uint8_t * source)
+{
+    __m256i vd = _mm256_loadu_si256((const __m256i*)destination);
+    __m256i vs = _mm256_loadu_si256((const __m256i*)source);
+    _mm256_storeu_si256((__m256i*)destination, _mm256_max_epu8(vd, vs));
+}
+
+/**
+ * @brief priorityMerge() of 32 slots
+ *
+ */
+inline void vectorPriorityMerge(uint8_t * levels, uint8_t * priorities, 
+    const uint8_t * sourceLevels, const uint8_t * sourcePriorities, bool highestTakesPrecedence)
+{
+    __m256i level = _mm256_loadu_si256((const __m256i*)levels);
+    __m256i priority = _mm256_loadu_si256((const __m256i*)priorities);
+    __m256i sourceLevel = _mm256_loadu_si256((const __m256i*)sourceLevels);
+    __m256i sourcePriority = _mm256_loadu_si256((const __m256i*)sourcePriorities);
+
+    __m256i undriven = _mm256_cmpeq_epi8(sourcePriority, _mm256_setzero_si256());
+    __m256i atLeast = _mm256_andnot_si256(undriven, _mm256_cmpeq_epi8(_mm256_max_epu8(sourcePriority, priority), sourcePriority));
+    __m256i higher = _mm256_andnot_si256(_mm256_cmpeq_epi8(sourcePriority, priority), atLeast);
+    __m256i candidate = highestTakesPrecedence ? _mm256_max_epu8(level, sourceLevel) : sourceLevel;
+
+    level = _mm256_blendv_epi8(_mm256_blendv_epi8(level, candidate, atLeast), sourceLevel, higher);
+    _mm256_storeu_si256((__m256i*)levels, level);
+    _mm256_storeu_si256((__m256i*)priorities, _mm256_max_epu8(priority, sourcePriority));
+}
+
+/**
+ * @brief number of bytes compared by differenceMask()
+ *
+ */
+const size_t VECTOR_SIZE = 32;
+
+#elif defined(SACNCPP_SIMD_SSE2)
+
+/**
+ * @brief bit i is set if byte i differs between the 16 bytes at a and b
+ *
+ */
+inline uint32_t differenceMask(const uint8_t * a, const uint8_t * b)
+{
+    __m128i va = _mm_loadu_si128((const __m128i*)a);
+    __m128i vb = _mm_loadu_si128((const __m128i*)b);
+    return ~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) & 0xFFFF;
+}
+
+/**
+ * @brief stores the bytewise maximum of the 16 bytes at destination and source to destination
+ *
+ */
+inline void vectorMaximum(uint8_t * destination, const uint8_t * source)
+{
+    __m128i vd = _mm_loadu_si128((const __m128i*)destination);
+    __m128i vs = _mm_loadu_si128((const __m128i*)source);
+    _mm_storeu_si128((__m128i*)destination, _mm_max_epu8(vd, vs));
+}
+
+/**
+ * @brief returns a where mask is set, b otherwise
+ *
+ */
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * @brief priorityMerge() of 16 slots
+ *
+ */
+inline void vectorPriorityMerge(uint8_t * levels, uint8_t * priorities, 
+    const uint8_t * sourceLevels, const uint8_t * sourcePriorities, bool highestTakesPrecedence)
+{
+    __m128i level = _mm_loadu_si128((const __m128i*)levels);
+    __m128i priority = _mm_loadu_si128((const __m128i*)priorities);
+    __m128i sourceLevel = _mm_loadu_si128((const __m128i*)sourceLevels);
+    __m128i sourcePriority = _mm_loadu_si128((const __m128i*)sourcePriorities);
+
+    __m128i undriven = _mm_cmpeq_epi8(sourcePriority, _mm_setzero_si128());
+    __m128i atLeast = _mm_andnot_si128(undriven, _mm_cmpeq_epi8(_mm_max_epu8(sourcePriority, priority), sourcePriority));
+    __m128i higher = _mm_andnot_si128(_mm_cmpeq_epi8(sourcePriority, priority), atLeast);
+    __m128i candidate = highestTakesPrecedence ? _mm_max_epu8(level, sourceLevel) : sourceLevel;
+
+    level = select(higher, sourceLevel, select(atLeast, candidate, level));
+    _mm_storeu_si128((__m128i*)levels, level);
+    _mm_storeu_si128((__m128i*)priorities, _mm_max_epu8(priority, sourcePriority));
+}
+
+/**
+ * @brief number of bytes compared by differenceMask()
+ *
+ */
+const size_t VECTOR_SIZE = 16;
+
+#endif
+
+#if defined(SACNCPP_SIMD_AVX2) || defined(SACNCPP_SIMD_SSE2)
+
+/**
+ * @brief returns if the first length bytes of a and b are equal
+ *
+ */
+inline bool equal(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    size_t i = 0;
+    for(; i + VECTOR_SIZE <= length; i += VECTOR_SIZE)
+    {
+        if(differenceMask(a+i, b+i))
+            return false;
+    }
+    return scalar::equal(a+i, b+i, length-i);
+}
+
+/**
+ * @brief returns the index of the first byte differing between a and b, or length if they are equal
+ *
+ */
+inline size_t firstDifference(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    size_t i = 0;
+    for(; i + VECTOR_SIZE <= length; i += VECTOR_SIZE)
+    {
+        uint32_t mask = differenceMask(a+i, b+i);
+        if(mask)
+            return i + lowestBit(mask);
+    }
+    return i + scalar::firstDifference(a+i, b+i, length-i);
+}
+
+/**
+ * @brief returns one past the index of the last byte differing between a and b, or 0 if they are equal
+ *
+ */
+inline size_t lastDifference(const uint8_t * a, const uint8_t * b, size_t length)
+{
+    // the bytes behind the last full vector are compared first
+    size_t i = length - length % VECTOR_SIZE;
+    size_t tail = scalar::lastDifference(a+i, b+i, length-i);
+    if(tail)
+        return i + tail;
+
+    while(i >= VECTOR_SIZE)
+    {
+        i -= VECTOR_SIZE;
+        uint32_t mask = differenceMask(a+i, b+i);
+        if(mask)
+            return i + highestBit(mask) + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief returns the mask of all channels differing between the 512 channels in a and b
+ *
+ */
+inline DMXChannelMask diff(const uint8_t * a, const uint8_t * b)
+{
+    DMXChannelMask result;
+    for(size_t word = 0; word < 8; word++)
+    {
+        uint64_t bits = 0;
+        for(size_t j = 0; j < 64; j += VECTOR_SIZE)
+        {
+            bits |= uint64_t(differenceMask(a + word*64 + j, b + word*64 + j)) << j;
+        }
+        result.words[word] = bits;
+    }
+    return result;
+}
+
+/**
+ * @brief highest takes precedence merge: sets each of the first length bytes of destination to the maximum of itself and source
+ *
+ */
+inline void maximum(uint8_t * destination, const uint8_t * source, size_t length)
+{
+    size_t i = 0;
+    for(; i + VECTOR_SIZE <= length; i += VECTOR_SIZE)
+        vectorMaximum(destination+i, source+i);
+    scalar::maximum(destination+i, source+i, length-i);
+}
+
+/**
+ * @brief per slot priority merge: merges the levels and priorities of a source into the current winners.
+ * Slots where the source has a higher priority take its level, slots with the same priority take the 
+ * maximum (HTP) or the source level (LTP). Slots with source priority 0 are not driven by the source.
+ *
+ * @param levels the winning levels so far, updated
+ * @param priorities the winning priorities so far, updated
+ * @param sourceLevels the levels of the source
+ * @param sourcePriorities the priorities of the source
+ * @param length number of slots
+ * @param highestTakesPrecedence true: HTP for equal priorities, false: LTP
+ */
+inline void priorityMerge(uint8_t * levels, uint8_t * priorities, 
+    const uint8_t * sourceLevels, const uint8_t * sourcePriorities, size_t length, bool highestTakesPrecedence)
+{
+    size_t i = 0;
+    for(; i + VECTOR_SIZE <= length; i += VECTOR_SIZE)
+        vectorPriorityMerge(levels+i, priorities+i, sourceLevels+i, sourcePriorities+i, highestTakesPrecedence);
+    scalar::priorityMerge(levels+i, priorities+i, sourceLevels+i, sourcePriorities+i, length-i, highestTakesPrecedence);
+}
+
+#else
+
+using scalar::equal;
+using scalar::firstDifference;
+using scalar::lastDifference;
+using scalar::diff;
+using scalar::maximum;
+using scalar::priorityMerge;
+
+#endif
+
+}
+
+}
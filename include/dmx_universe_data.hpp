@@ -1,12 +1,42 @@
 #pragma once
+#include <stdint.h>
 #include <array>
+#include <cstring>
+#include <atomic>
+#include <thread>
 #include <shared_mutex>
+#include <mutex>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+#include <dmx_simd.hpp>
 
 namespace sACNcpp {
 
+/**
+ * @brief How concurrent access to the values of a DMXUniverseData object is synchronized
+ * 
+ */
+enum class DMXSynchronization
+{
+    /**
+     * @brief readers and writers take a std::shared_timed_mutex
+     * 
+     */
+    Mutex,
+
+    /**
+     * @brief writers increment a sequence counter before and after writing, readers retry if the 
+     * counter changed while they were reading. Readers never block writers, and neither side 
+     * waits in the kernel. Best suited for few writers and frequent readers.
+     * 
+     */
+    SeqLock
+};
+
 class DMXUniverseData {
     /**
      * @brief A wrapper around a std::array providing 
@@ -16,15 +46,165 @@ class DMXUniverseData {
 
 public:
 
+    /**
+     * @brief Exclusive write access to a DMXUniverseData object, to update many channels at once.
+     * 
+     * The lock is taken once when the transaction is created by DMXUniverseData::begin(), and released 
+     * by commit() or when the transaction is destroyed. Readers (e.g. the sending thread) either see the 
+     * state before or after the transaction, never a half written frame. 
+     * Readers wait while the transaction is open, so keep it short.
+     * 
+     */
+    class Transaction
+    {
+    public:
+        Transaction(const Transaction&) = delete;
+        Transaction& operator=(const Transaction&) = delete;
+
+        /**
+         * @brief Move constructor, the moved from transaction is closed.
+         * 
+         */
+        Transaction(Transaction&& other) : 
+            m_data(other.m_data), 
+            m_sequence(other.m_sequence)
+        {
+            other.m_data = nullptr;
+        }
+
+        /**
+         * @brief Destroy the Transaction object, committing it if commit() was not called yet.
+         * 
+         */
+        ~Transaction()
+        {
+            commit();
+        }
+
+        /**
+         * @brief A reference to a single channel inside a transaction
+         * 
+         */
+        class ChannelReference
+        {
+        public:
+            /**
+             * @brief sets the channel to value
+             * 
+             */
+            ChannelReference& operator=(uint8_t value)
+            {
+                m_data->writeChannel(m_channel, value);
+                return *this;
+            }
+
+            /**
+             * @brief the current value of the channel
+             * 
+             */
+            operator uint8_t() const
+            {
+                return m_data->m_data[m_channel];
+            }
+
+        private:
+            friend class Transaction;
+
+            ChannelReference(DMXUniverseData* data, uint16_t channel) : 
+                m_data(data), 
+                m_channel(channel)
+            {
+            }
+
+            DMXUniverseData* m_data;
+            uint16_t m_channel;
+        };
+
+        /**
+         * @brief gives write access to a channel
+         * 
+         * @param channel the channel to access
+         * @return ChannelReference reference to the channel, assignable like a uint8_t&
+         */
+        ChannelReference operator[](uint16_t channel)
+        {
+            return ChannelReference(m_data, channel);
+        }
+
+        /**
+         * @brief sets consecutive channels from a buffer
+         * 
+         * @param offset the first channel to set
+         * @param data the buffer to read from
+         * @param length number of channels to set
+         */
+        void setRange(uint16_t offset, const uint8_t * data, uint16_t length)
+        {
+            if(offset+length > 512)
+                throw std::out_of_range("offset+length would write to channel > 512");
+
+            m_data->copyChanged(offset, data, length);
+        }
+
+        /**
+         * @brief Publishes all changes and releases the lock. The transaction can not be used afterwards.
+         * 
+         */
+        void commit()
+        {
+            if(m_data == nullptr)
+                return;
+
+            m_data->unlockWrite(m_sequence);
+            m_data = nullptr;
+        }
+
+    private:
+        friend class DMXUniverseData;
+
+        /**
+         * @brief Construct a new Transaction object, taking the write lock of data
+         * 
+         */
+        Transaction(DMXUniverseData& data) : 
+            m_data(&data), 
+            m_sequence(data.lockWrite())
+        {
+        }
+
+        /**
+         * @brief the object written to, nullptr once committed
+         * 
+         */
+        DMXUniverseData* m_data;
+
+        /**
+         * @brief the sequence counter returned by lockWrite()
+         * 
+         */
+        uint32_t m_sequence;
+    };
+
     /**
      * @brief Construct a new DMXUniverseData object
      * 
+     * @param synchronization how concurrent access to the values is synchronized
      */
-    DMXUniverseData() 
+    DMXUniverseData(DMXSynchronization synchronization = DMXSynchronization::Mutex) :
+        m_synchronization(synchronization)
     {
         m_data.fill(0);
     }
 
+    /**
+     * @brief returns how concurrent access to the values of this object is synchronized
+     * 
+     */
+    DMXSynchronization synchronization() const
+    {
+        return m_synchronization;
+    }
+
     /**
      * @brief Reads DMX data from a given buffer
      * 
@@ -33,13 +213,80 @@ public:
      */
     void read(const uint8_t * data, uint16_t length)
     {
-        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
-        
-        bool changed = false;     
-        for(uint16_t i = 0; i < length; i++)
-        {            
-            m_data[i] = data[i];
-        }
+        modify([&]()
+        {
+            copyChanged(0, data, length);
+        });
+    }
+
+    /**
+     * @brief Sets consecutive channels from a buffer, taking the lock only once.
+     * 
+     * @param offset the first channel to set
+     * @param data the buffer to read from
+     * @param length number of channels to set
+     */
+    void setRange(uint16_t offset, const uint8_t * data, uint16_t length)
+    {
+        if(offset+length > 512)
+            throw std::out_of_range("offset+length would write to channel > 512");
+
+        modify([&]()
+        {
+            copyChanged(offset, data, length);
+        });
+    }
+
+    /**
+     * @brief A counter incremented whenever any channel changes. Writes that do not change 
+     * a value do not increment it. Comparing it to a previously read value is an O(1) change check.
+     * 
+     * @return uint64_t the current generation
+     */
+    uint64_t generation() const
+    {
+        return m_generation.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Copies the channels changed since the last call to data and resets the tracked range.
+     * Intended for a single consumer mirroring the values, e.g. the packet sent to sACN.
+     * 
+     * @param data buffer of 512 values, only the changed range is written
+     * @param first set to the first channel written
+     * @param last set to one past the last channel written
+     * @return true: channels changed and were copied
+     * @return false: nothing changed since the last call
+     */
+    bool writeDirty(uint8_t * data, uint16_t& first, uint16_t& last)
+    {
+        uint32_t sequence = lockWrite();
+
+        first = m_dirtyFirst;
+        last = m_dirtyLast;
+        memcpy(data+first, m_data.data()+first, last-first);
+        m_dirtyFirst = 0;
+        m_dirtyLast = 0;
+
+        unlockWrite(sequence);
+        return first < last;
+    }
+
+    /**
+     * @brief Opens a transaction to update many channels while taking the lock only once.
+     * 
+     * @code
+     * auto tx = dmx.begin();
+     * tx[1] = 255;
+     * tx[2] = 127;
+     * tx.commit();
+     * @endcode
+     * 
+     * @return Transaction the open transaction
+     */
+    Transaction begin()
+    {
+        return Transaction(*this);
     }
 
     /**
@@ -49,14 +296,13 @@ public:
      * @param length the length to write. if none is 
      * specified, all 512 channels will be written. 
      */
-    void write(uint8_t * data, uint16_t length)
+    void write(uint8_t * data, uint16_t length) const
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-        
-        for(uint16_t i = 0; i < length; i++)
+        inspect([&](const std::array<uint8_t, 512>& values)
         {
-            data[i] = m_data[i];
-        }
+            memcpy(data, values.data(), length);
+            return true;
+        });
     }
 
     /**
@@ -66,17 +312,29 @@ public:
      */
     DMXUniverseData& operator=(const DMXUniverseData& src)
     {
-        std::lock_guard<std::shared_timed_mutex> readLock(m_mutex);
-        std::shared_lock<std::shared_timed_mutex> writeLock(src.m_mutex);
+        std::array<uint8_t, 512> snapshot = src.values();
 
-        for(uint16_t i = 0; i < 512; i++)
+        modify([&]()
         {
-            m_data[i] = src.m_data[i];                
-        }
+            copyChanged(0, snapshot.data(), 512);
+        });
 
         return *this;
     }
 
+    /**
+     * @brief returns a consistent copy of all 512 values
+     * 
+     * @return std::array<uint8_t, 512> 
+     */
+    std::array<uint8_t, 512> values() const
+    {
+        return inspect([](const std::array<uint8_t, 512>& values)
+        {
+            return values;
+        });
+    }
+
     /**
      * @brief Reads a multichannel dmx value (fine/ultra/.. resolution) from this packet.
      * 
@@ -89,12 +347,15 @@ public:
         if(channel+resolution > 512)
             throw std::out_of_range("channel+resolution would read from channel > 512");
 
-        long rawValue = 0;
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-        for(uint8_t i = 0; i < resolution; i++)
+        long rawValue = inspect([&](const std::array<uint8_t, 512>& values)
         {
-            rawValue += m_data[channel+resolution-i-1]*pow(256, i);
-        }
+            long result = 0;
+            for(uint8_t i = 0; i < resolution; i++)
+            {
+                result += values[channel+resolution-i-1]*pow(256, i);
+            }
+            return result;
+        });
 
         return rawValue / (pow(256, resolution)-1);
     }
@@ -113,12 +374,14 @@ public:
 
         long val = value * (pow(256, resolution)-1);
 
-        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
-        for(uint8_t i = 0; i < resolution; i++)
+        modify([&]()
         {
-            m_data[channel+resolution-i-1] = val % 256;
-            val /= 256;
-        }
+            for(uint8_t i = 0; i < resolution; i++)
+            {
+                writeChannel(channel+resolution-i-1, val % 256);
+                val /= 256;
+            }
+        });
     }
 
     /**
@@ -127,10 +390,12 @@ public:
      * @param channel the channel to return the value of
      * @return const uint8_t value of channel
      */
-    const uint8_t operator[](uint16_t channel)
+    const uint8_t operator[](uint16_t channel) const
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-        return m_data[channel];
+        return inspect([&](const std::array<uint8_t, 512>& values)
+        {
+            return values[channel];
+        });
     }
 
     /**
@@ -141,8 +406,10 @@ public:
      */
     void set(uint16_t channel, uint8_t value)
     {
-        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
-        m_data[channel] = value;
+        modify([&]()
+        {
+            writeChannel(channel, value);
+        });
     }
 
     /**
@@ -153,15 +420,28 @@ public:
      */
     bool operator==(const DMXUniverseData& other) const
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-        std::shared_lock<std::shared_timed_mutex> writeLock(other.m_mutex);
+        std::array<uint8_t, 512> otherValues = other.values();
 
-        for(uint16_t i = 0; i < 512; i++)
+        return inspect([&](const std::array<uint8_t, 512>& values)
         {
-            if(other.m_data[i] != m_data[i])
-                return false;                
-        }
-        return true;
+            return simd::equal(otherValues.data(), values.data(), 512);
+        });
+    }
+
+    /**
+     * @brief compares all channels to another DMXUniverseData in a single pass
+     * 
+     * @param other the DMXUniverseData to compare to
+     * @return DMXChannelMask the mask of all channels with different values
+     */
+    DMXChannelMask diff(const DMXUniverseData& other) const
+    {
+        std::array<uint8_t, 512> otherValues = other.values();
+
+        return inspect([&](const std::array<uint8_t, 512>& values)
+        {
+            return simd::diff(otherValues.data(), values.data());
+        });
     }
     
     /**
@@ -179,9 +459,9 @@ public:
      * @brief prints the stored dmx data to the console.
      * 
      */
-    void print()
+    void print() const
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
+        std::array<uint8_t, 512> values = this->values();
         std::cout << "---------------------------------" << std::endl;
         for(int i = 0; i < 32; i++)
         {
@@ -190,7 +470,7 @@ public:
             {
                 uint16_t channel = i*16+j;
 
-                std::cout << std::setw(3) << (int)m_data[channel] << " ";
+                std::cout << std::setw(3) << (int)values[channel] << " ";
             }
 
             std::cout << std::endl;
@@ -200,6 +480,197 @@ public:
 
 private:
 
+    /**
+     * @brief Runs f with exclusive write access to the values. f has to change the values 
+     * through writeChannel() or copyChanged(), so changes are tracked.
+     * 
+     * @param f function without parameters
+     */
+    template<typename Function>
+    void modify(Function f)
+    {
+        uint32_t sequence = lockWrite();
+        f();
+        unlockWrite(sequence);
+    }
+
+    /**
+     * @brief Sets a channel and tracks the change. The write lock has to be held.
+     * 
+     */
+    void writeChannel(uint16_t channel, uint8_t value)
+    {
+        if(m_data[channel] == value)
+            return;
+
+        m_data[channel] = value;
+        markDirty(channel, channel+1);
+    }
+
+    /**
+     * @brief Copies consecutive channels from a buffer and tracks the changed ones. The write lock has to be held.
+     * 
+     */
+    void copyChanged(uint16_t offset, const uint8_t * data, uint16_t length)
+    {
+        uint8_t* values = m_data.data()+offset;
+
+        uint16_t first = simd::firstDifference(values, data, length);
+        if(first == length)
+            return;
+
+        uint16_t last = first + simd::lastDifference(values+first, data+first, length-first);
+
+        memcpy(values+first, data+first, last-first);
+        markDirty(offset+first, offset+last);
+    }
+
+    /**
+     * @brief Extends the dirty range to cover the channels first to last-1. The write lock has to be held.
+     * 
+     */
+    void markDirty(uint16_t first, uint16_t last)
+    {
+        if(m_dirtyFirst >= m_dirtyLast)
+        {
+            m_dirtyFirst = first;
+            m_dirtyLast = last;
+        }
+        else
+        {
+            m_dirtyFirst = std::min(m_dirtyFirst, first);
+            m_dirtyLast = std::max(m_dirtyLast, last);
+        }
+        m_changed = true;
+    }
+
+    /**
+     * @brief Takes exclusive write access to m_data.
+     * 
+     * @return uint32_t the sequence counter before writing, to be passed to unlockWrite()
+     */
+    uint32_t lockWrite()
+    {
+        if(m_synchronization == DMXSynchronization::SeqLock)
+        {
+            // claim the write side by making the sequence odd
+            uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+            while((sequence & 1) || !m_sequence.compare_exchange_weak(sequence, sequence+1, std::memory_order_acquire))
+            {
+                cpuRelax();
+                sequence = m_sequence.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            return sequence;
+        }
+
+        m_mutex.lock();
+        return 0;
+    }
+
+    /**
+     * @brief Releases the write access taken by lockWrite(), publishing the changes.
+     * 
+     * @param sequence the value returned by lockWrite()
+     */
+    void unlockWrite(uint32_t sequence)
+    {
+        if(m_changed)
+        {
+            m_generation.fetch_add(1, std::memory_order_release);
+            m_changed = false;
+        }
+
+        if(m_synchronization == DMXSynchronization::SeqLock)
+            m_sequence.store(sequence+2, std::memory_order_release);
+        else
+            m_mutex.unlock();
+    }
+
+    /**
+     * @brief Runs f with read access to a consistent state of the values and returns its result.
+     * In SeqLock mode f may run multiple times and may see torn values during a run that is 
+     * retried, so it must only read the values into its result.
+     * 
+     * @param f function taking a const std::array<uint8_t, 512>& and returning the result
+     */
+    template<typename Function>
+    auto inspect(Function f) const -> decltype(f(std::declval<const std::array<uint8_t, 512>&>()))
+    {
+        if(m_synchronization == DMXSynchronization::SeqLock)
+        {
+            while(true)
+            {
+                uint32_t before = m_sequence.load(std::memory_order_acquire);
+                if(before & 1)
+                {
+                    cpuRelax();
+                    continue;
+                }
+
+                auto result = f(m_data);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(m_sequence.load(std::memory_order_relaxed) == before)
+                    return result;
+            }
+        }
+        else
+        {
+            std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
+            return f(m_data);
+        }
+    }
+
+    /**
+     * @brief hints the cpu that the calling thread is spinning
+     * 
+     */
+    static void cpuRelax()
+    {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_ia32_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief how concurrent access to m_data is synchronized
+     * 
+     */
+    const DMXSynchronization m_synchronization;
+
+    /**
+     * @brief the sequence counter used in SeqLock mode, odd while a writer is active
+     * 
+     */
+    std::atomic<uint32_t> m_sequence{0};
+
+    /**
+     * @brief incremented whenever the values change
+     * 
+     */
+    std::atomic<uint64_t> m_generation{0};
+
+    /**
+     * @brief first channel changed since the last call to writeDirty()
+     * 
+     */
+    uint16_t m_dirtyFirst = 0;
+
+    /**
+     * @brief one past the last channel changed since the last call to writeDirty()
+     * 
+     */
+    uint16_t m_dirtyLast = 0;
+
+    /**
+     * @brief true if values changed while the write lock is held
+     * 
+     */
+    bool m_changed = false;
+
     /**
      * @brief the array storing the dmx data
      * 
@@ -207,7 +678,7 @@ private:
     std::array<uint8_t, 512> m_data;
 
     /**
-     * @brief a mutex protecting the data array
+     * @brief a mutex protecting the data array in Mutex mode
      * 
      */
     mutable std::shared_timed_mutex m_mutex;
@@ -0,0 +1,256 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+
+namespace sACNcpp {
+
+/**
+ * @brief A snapshot of the timing metrics of a FrameScheduler
+ *
+ */
+struct FrameSchedulerMetrics
+{
+    /**
+     * @brief number of frames started
+     *
+     */
+    uint64_t ticks = 0;
+
+    /**
+     * @brief number of frame deadlines that passed while the previous frame was still being worked on
+     *
+     */
+    uint64_t missedDeadlines = 0;
+
+    /**
+     * @brief time spent working on the last frame
+     *
+     */
+    std::chrono::nanoseconds lastWorkDuration{0};
+
+    /**
+     * @brief longest time spent working on a frame
+     *
+     */
+    std::chrono::nanoseconds maxWorkDuration{0};
+
+    /**
+     * @brief delay between the deadline and the actual wake up of the last frame
+     *
+     */
+    std::chrono::nanoseconds lastJitter{0};
+
+    /**
+     * @brief longest delay between a deadline and the actual wake up
+     *
+     */
+    std::chrono::nanoseconds maxJitter{0};
+};
+
+/**
+ * @brief Paces a loop to a fixed frame rate using absolute deadlines on the steady clock.
+ *
+ * Deadlines are computed as multiples of the frame period, so the time spent working on a
+ * frame does not shift the following frames. If a frame overruns one or more deadlines,
+ * those frames are skipped and counted as missed.
+ * waitForNextFrame() has to be called by a single thread, metrics() may be called from any thread.
+ *
+ */
+class FrameScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /**
+     * @brief Construct a new FrameScheduler object
+     *
+     * @param frameRate the number of frames per second, has to be greater than 0
+     */
+    FrameScheduler(double frameRate = 44.0)
+    {
+        setFrameRate(frameRate);
+    }
+
+    /**
+     * @brief Set the frame rate. Takes effect with the next frame.
+     *
+     * @param frameRate the number of frames per second, has to be greater than 0
+     */
+    void setFrameRate(double frameRate)
+    {
+        if(!(frameRate > 0))
+            throw std::invalid_argument("The frame rate has to be greater than 0.");
+
+        m_period.store(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frameRate)).count());
+    }
+
+    /**
+     * @brief the current frame rate in frames per second
+     *
+     */
+    double frameRate() const
+    {
+        return 1.0 / std::chrono::duration<double>(period()).count();
+    }
+
+    /**
+     * @brief Restarts the schedule, the first deadline will be one period from now.
+     *
+     */
+    void start()
+    {
+        m_nextDeadline = Clock::now() + period();
+        m_working = false;
+    }
+
+    /**
+     * @brief Sleeps until the deadline of the next frame. Everything between two calls is accounted as work of one frame.
+     *
+     * @return Clock::time_point the deadline of the frame that starts now
+     */
+    Clock::time_point waitForNextFrame()
+    {
+        Clock::duration framePeriod = period();
+        Clock::time_point now = Clock::now();
+
+        if(m_working)
+            record(m_lastWorkDuration, m_maxWorkDuration, now - m_wakeUp);
+
+        if(now >= m_nextDeadline)
+        {
+            // skip all deadlines that already passed, keeping the frames aligned to the schedule
+            uint64_t missed = (now - m_nextDeadline) / framePeriod + 1;
+            m_missedDeadlines.fetch_add(missed, std::memory_order_relaxed);
+            m_nextDeadline += framePeriod * missed;
+        }
+
+        std::this_thread::sleep_until(m_nextDeadline);
+
+        m_wakeUp = Clock::now();
+        m_working = true;
+        record(m_lastJitter, m_maxJitter, m_wakeUp - m_nextDeadline);
+        m_ticks.fetch_add(1, std::memory_order_relaxed);
+
+        Clock::time_point deadline = m_nextDeadline;
+        m_nextDeadline += framePeriod;
+        return deadline;
+    }
+
+    /**
+     * @brief returns a snapshot of the timing metrics
+     *
+     */
+    FrameSchedulerMetrics metrics() const
+    {
+        FrameSchedulerMetrics result;
+        result.ticks = m_ticks.load(std::memory_order_relaxed);
+        result.missedDeadlines = m_missedDeadlines.load(std::memory_order_relaxed);
+        result.lastWorkDuration = std::chrono::nanoseconds(m_lastWorkDuration.load(std::memory_order_relaxed));
+        result.maxWorkDuration = std::chrono::nanoseconds(m_maxWorkDuration.load(std::memory_order_relaxed));
+        result.lastJitter = std::chrono::nanoseconds(m_lastJitter.load(std::memory_order_relaxed));
+        result.maxJitter = std::chrono::nanoseconds(m_maxJitter.load(std::memory_order_relaxed));
+        return result;
+    }
+
+    /**
+     * @brief resets all metrics to zero
+     *
+     */
+    void resetMetrics()
+    {
+        m_ticks.store(0, std::memory_order_relaxed);
+        m_missedDeadlines.store(0, std::memory_order_relaxed);
+        m_lastWorkDuration.store(0, std::memory_order_relaxed);
+        m_maxWorkDuration.store(0, std::memory_order_relaxed);
+        m_lastJitter.store(0, std::memory_order_relaxed);
+        m_maxJitter.store(0, std::memory_order_relaxed);
+    }
+
+private:
+
+    /**
+     * @brief the current frame period
+     *
+     */
+    Clock::duration period() const
+    {
+        return Clock::duration(m_period.load());
+    }
+
+    /**
+     * @brief stores a duration as the last value, and as the maximum value if it exceeds it
+     *
+     */
+    static void record(std::atomic<int64_t>& last, std::atomic<int64_t>& max, Clock::duration value)
+    {
+        int64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(value).count();
+        last.store(nanoseconds, std::memory_order_relaxed);
+        if(nanoseconds > max.load(std::memory_order_relaxed))
+            max.store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief the frame period, in Clock::duration ticks
+     *
+     */
+    std::atomic<Clock::rep> m_period;
+
+    /**
+     * @brief the deadline of the next frame
+     *
+     */
+    Clock::time_point m_nextDeadline;
+
+    /**
+     * @brief the time the current frame started
+     *
+     */
+    Clock::time_point m_wakeUp;
+
+    /**
+     * @brief true while a frame is being worked on
+     *
+     */
+    bool m_working = false;
+
+    /**
+     * @brief number of frames started
+     *
+     */
+    std::atomic<uint64_t> m_ticks{0};
+
+    /**
+     * @brief number of deadlines skipped because of overrunning frames
+     *
+     */
+    std::atomic<uint64_t> m_missedDeadlines{0};
+
+    /**
+     * @brief work duration of the last frame, in nanoseconds
+     *
+     */
+    std::atomic<int64_t> m_lastWorkDuration{0};
+
+    /**
+     * @brief longest work duration, in nanoseconds
+     *
+     */
+    std::atomic<int64_t> m_maxWorkDuration{0};
+
+    /**
+     * @brief wake up delay of the last frame, in nanoseconds
+     *
+     */
+    std::atomic<int64_t> m_lastJitter{0};
+
+    /**
+     * @brief longest wake up delay, in nanoseconds
+     *
+     */
+    std::atomic<int64_t> m_maxJitter{0};
+};
+
+}
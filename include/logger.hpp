@@ -4,6 +4,8 @@
 #include <chrono>
 #include <iomanip>
 #include <ctime>
+#include <atomic>
+#include <utility>
 
 namespace sACNcpp 
 {
@@ -69,7 +71,8 @@ namespace sACNcpp
      * @brief The static logger used in this package.
      * 
      * You can set you own logger implementing the LogInterface
-     * using the setLogger method.
+     * using the setLogger method. Entries below the level set with setLevel() are discarded 
+     * before they reach the logger, use SACNCPP_LOG to also skip formatting their text.
      */
     class Logger
     {
@@ -83,10 +86,25 @@ namespace sACNcpp
              */
             static void Log(LogLevel loglevel, std::string text)
             {
-                if(getLogHandlerRef() == nullptr)
+                if(loglevel < getLevelRef().load(std::memory_order_relaxed))
                     return;
 
-                getLogHandlerRef()->Log(loglevel, text);
+                LogInterface* handler = getLogHandlerRef().load(std::memory_order_acquire);
+                if(handler == nullptr)
+                    return;
+
+                handler->Log(loglevel, std::move(text));
+            }
+
+            /**
+             * @brief Returns if entries of a level would be logged. Cheap enough to be checked before formatting every entry.
+             * 
+             * @param loglevel loglevel of the entry
+             */
+            static bool enabled(LogLevel loglevel)
+            {
+                return loglevel >= getLevelRef().load(std::memory_order_relaxed) && 
+                    getLogHandlerRef().load(std::memory_order_relaxed) != nullptr;
             }
 
             /**
@@ -96,7 +114,35 @@ namespace sACNcpp
              */
             static void setLogger(LogInterface* logger)
             {
-                getLogHandlerRef() = logger;                
+                getLogHandlerRef().store(logger, std::memory_order_release);
+            }
+
+            /**
+             * @brief Returns the Logger in use, nullptr if logging is disabled
+             * 
+             */
+            static LogInterface* logger()
+            {
+                return getLogHandlerRef().load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Set the lowest level that is logged. Defaults to LogLevel::Info.
+             * 
+             * @param loglevel the lowest level logged
+             */
+            static void setLevel(LogLevel loglevel)
+            {
+                getLevelRef().store(loglevel, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Returns the lowest level that is logged
+             * 
+             */
+            static LogLevel level()
+            {
+                return getLevelRef().load(std::memory_order_relaxed);
             }
 
         private:
@@ -104,13 +150,36 @@ namespace sACNcpp
             /**
              * @brief Used to statically store the Logging handler
              * 
-             * @return LogInterface*& 
+             * @return std::atomic<LogInterface*>& 
              */
-            static LogInterface*& getLogHandlerRef()
+            static std::atomic<LogInterface*>& getLogHandlerRef()
             {
                 static DefaultLogger defaultLogger;
-                static LogInterface* currentLogHandler = &defaultLogger;
+                static std::atomic<LogInterface*> currentLogHandler{&defaultLogger};
                 return currentLogHandler;
             }
+
+            /**
+             * @brief Used to statically store the lowest level logged
+             * 
+             * @return std::atomic<LogLevel>& 
+             */
+            static std::atomic<LogLevel>& getLevelRef()
+            {
+                static std::atomic<LogLevel> currentLevel{LogLevel::Info};
+                return currentLevel;
+            }
     };
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Logs an entry, evaluating the text only if the level is enabled, e.g. 
+ * SACNCPP_LOG(sACNcpp::LogLevel::Debug, "Universe " + std::to_string(universe) + " received new packet.");
+ * 
+ */
+#define SACNCPP_LOG(loglevel, text) \
+    do \
+    { \
+        if(::sACNcpp::Logger::enabled(loglevel)) \
+            ::sACNcpp::Logger::Log(loglevel, text); \
+    } while(0)
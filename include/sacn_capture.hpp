@@ -0,0 +1,928 @@
+#pragma once
+#include <stdint.h>
+#include <sacn_packet.hpp>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sACNcpp {
+
+/**
+ * @brief The kinds of records in a capture file
+ *
+ */
+enum class sACNCaptureRecordType : uint8_t
+{
+    /**
+     * @brief a data packet, the payload holds all slots
+     *
+     */
+    Data = 0,
+
+    /**
+     * @brief a data packet, the payload holds the slots that changed since the previous packet of the same
+     * source, universe and start code as runs of (uint16_t offset, uint16_t length, length slots)
+     *
+     */
+    Delta = 1,
+
+    /**
+     * @brief a synchronization packet, universe holds the synchronization address
+     *
+     */
+    Sync = 2,
+
+    /**
+     * @brief declares a source, the payload holds its CID (16 bytes) followed by its name.
+     * Precedes the first packet of the source and is repeated when its name changes.
+     *
+     */
+    Source = 3
+};
+
+/**
+ * @brief A record of a capture file. The payload points into the memory of the sACNCaptureReader.
+ *
+ */
+struct sACNCaptureRecord
+{
+    /**
+     * @brief the time the packet was received, in nanoseconds since the capture started
+     *
+     */
+    uint64_t timestamp = 0;
+
+    /**
+     * @brief the kind of the record
+     *
+     */
+    sACNCaptureRecordType type = sACNCaptureRecordType::Data;
+
+    /**
+     * @brief the index of the source in the order the sources were declared
+     *
+     */
+    uint16_t source = 0;
+
+    /**
+     * @brief the universe of a data packet, or the synchronization address of a synchronization packet
+     *
+     */
+    uint16_t universe = 0;
+
+    /**
+     * @brief the priority of a data packet
+     *
+     */
+    uint8_t priority = 0;
+
+    /**
+     * @brief the sequence number of the packet
+     *
+     */
+    uint8_t sequence = 0;
+
+    /**
+     * @brief the options flags of a data packet
+     *
+     */
+    uint8_t options = 0;
+
+    /**
+     * @brief the start code of a data packet
+     *
+     */
+    uint8_t startCode = 0;
+
+    /**
+     * @brief the synchronization address of a data packet
+     *
+     */
+    uint16_t syncAddress = 0;
+
+    /**
+     * @brief the number of slots of a data packet
+     *
+     */
+    uint16_t slots = 0;
+
+    /**
+     * @brief the number of bytes at payload
+     *
+     */
+    uint16_t payloadLength = 0;
+
+    /**
+     * @brief the payload, see sACNCaptureRecordType
+     *
+     */
+    const uint8_t* payload = nullptr;
+};
+
+/**
+ * @brief The layout of capture files. All numbers are little endian.
+ *
+ * A file starts with a header of 24 bytes: the magic "sACNCAP1", the version (uint32_t),
+ * reserved bytes (uint32_t) and the wall clock time the capture started (int64_t nanoseconds since the epoch).
+ * It is followed by records of a 23 byte header and a payload: timestamp (uint64_t), type (uint8_t),
+ * source (uint16_t), universe (uint16_t), priority, sequence, options, start code (uint8_t each),
+ * synchronization address (uint16_t), slots (uint16_t) and the length of the payload (uint16_t).
+ *
+ */
+namespace sACNCaptureFormat
+{
+    static const char magic[8] = {'s', 'A', 'C', 'N', 'C', 'A', 'P', '1'};
+    static const uint32_t version = 1;
+    static const size_t headerSize = 24;
+    static const size_t recordHeaderSize = 23;
+
+    inline void put16(uint8_t* target, uint16_t value)
+    {
+        target[0] = value & 0xFF;
+        target[1] = value >> 8;
+    }
+
+    inline void put32(uint8_t* target, uint32_t value)
+    {
+        put16(target, value & 0xFFFF);
+        put16(target + 2, value >> 16);
+    }
+
+    inline void put64(uint8_t* target, uint64_t value)
+    {
+        put32(target, value & 0xFFFFFFFF);
+        put32(target + 4, value >> 32);
+    }
+
+    inline uint16_t get16(const uint8_t* source)
+    {
+        return source[0] | (source[1] << 8);
+    }
+
+    inline uint32_t get32(const uint8_t* source)
+    {
+        return get16(source) | ((uint32_t)get16(source + 2) << 16);
+    }
+
+    inline uint64_t get64(const uint8_t* source)
+    {
+        return get32(source) | ((uint64_t)get32(source + 4) << 32);
+    }
+
+    /**
+     * @brief the key of the stream of a data packet, delta records refer to the previous packet of their stream
+     *
+     */
+    inline uint64_t streamKey(uint16_t source, uint16_t universe, uint8_t startCode)
+    {
+        return ((uint64_t)source << 24) | ((uint64_t)universe << 8) | startCode;
+    }
+}
+
+/**
+ * @brief Writes the packets received by a sACNInput to a capture file, see sACNInput::setCapture().
+ *
+ * Data packets are stored as the slots that changed since the previous packet of the same source, universe and
+ * start code, if that is smaller than all slots. CIDs and source names are stored once per source.
+ * write() may be called from several threads, the records are appended to a buffer under a mutex and written
+ * to the file when the buffer is full.
+ *
+ */
+class sACNCaptureWriter
+{
+public:
+
+    /**
+     * @brief Creates the capture file and writes its header. An existing file is overwritten.
+     *
+     * @throw std::runtime_error if the file could not be created
+     * @param path the path of the file
+     * @param bufferSize the number of bytes buffered before writing to the file
+     */
+    sACNCaptureWriter(const std::string& path, size_t bufferSize = 1 << 20) :
+        m_buffer(bufferSize),
+        m_start(std::chrono::steady_clock::now())
+    {
+        m_file.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if(!m_file)
+            throw std::runtime_error("Could not create the capture file " + path + ".");
+
+        uint8_t header[sACNCaptureFormat::headerSize] = {0};
+        memcpy(header, sACNCaptureFormat::magic, sizeof(sACNCaptureFormat::magic));
+        sACNCaptureFormat::put32(header + 8, sACNCaptureFormat::version);
+        sACNCaptureFormat::put64(header + 16, std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        m_file.write((const char*)header, sizeof(header));
+        m_bytes = sizeof(header);
+    }
+
+    sACNCaptureWriter(const sACNCaptureWriter&) = delete;
+    sACNCaptureWriter& operator=(const sACNCaptureWriter&) = delete;
+
+    /**
+     * @brief Destroy the sACNCaptureWriter object, writing all buffered records
+     *
+     */
+    ~sACNCaptureWriter()
+    {
+        close();
+    }
+
+    /**
+     * @brief Appends a packet. Packets that are neither valid data nor valid synchronization packets are ignored.
+     *
+     * @param packet the packet received
+     * @param received the time the packet was received
+     * @return true: the packet was appended
+     * @return false: the packet was ignored, or the file was closed or could not be written
+     */
+    bool write(const sACNPacket& packet, std::chrono::steady_clock::time_point received)
+    {
+        bool sync = packet.isSyncPacket();
+        if(sync ? !packet.validSync() : !packet.valid())
+            return false;
+
+        uint64_t timestamp = received > m_start ?
+            std::chrono::duration_cast<std::chrono::nanoseconds>(received - m_start).count() : 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_file.is_open())
+            return false;
+
+        uint16_t source = sourceIndex(packet, timestamp);
+
+        if(sync)
+        {
+            m_record.resize(sACNCaptureFormat::recordHeaderSize);
+            writeHeader(timestamp, sACNCaptureRecordType::Sync, source, packet.syncAddress(), 0,
+                packet.sequenceNumber(), 0, 0, 0, 0);
+            m_packets++;
+            return append();
+        }
+
+        const sacn_packet_struct* packed = packet.getPackedPacket();
+        uint16_t slots = packet.numDMXSlots();
+        Frame& previous = m_frames[sACNCaptureFormat::streamKey(source, packet.universe(), packet.startCode())];
+
+        m_record.resize(sACNCaptureFormat::recordHeaderSize);
+        sACNCaptureRecordType type = sACNCaptureRecordType::Data;
+        if(previous.slots == slots && encodeDelta(previous.data.data(), packet.slotData(), slots))
+            type = sACNCaptureRecordType::Delta;
+        else
+            m_record.insert(m_record.end(), packet.slotData(), packet.slotData() + slots);
+
+        writeHeader(timestamp, type, source, packet.universe(), packet.priority(), packet.sequenceNumber(),
+            packed->frame.options, packet.startCode(), packet.syncAddress(), slots);
+
+        previous.slots = slots;
+        memcpy(previous.data.data(), packet.slotData(), slots);
+        m_packets++;
+        return append();
+    }
+
+    /**
+     * @brief Writes all buffered records to the file
+     *
+     * @return true: the records were written
+     * @return false: the file was closed or could not be written
+     */
+    bool flush()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_file.is_open())
+            return false;
+        return static_cast<bool>(m_file.flush());
+    }
+
+    /**
+     * @brief Writes all buffered records and closes the file. Further packets are ignored.
+     *
+     */
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(m_file.is_open())
+            m_file.close();
+    }
+
+    /**
+     * @brief the number of packets appended
+     *
+     */
+    uint64_t packets()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_packets;
+    }
+
+    /**
+     * @brief the size of the capture, including the buffered records
+     *
+     */
+    uint64_t bytes()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bytes;
+    }
+
+private:
+
+    /**
+     * @brief the slots of the previous packet of a stream
+     *
+     */
+    struct Frame
+    {
+        uint16_t slots = 0xFFFF;
+        std::array<uint8_t, 512> data;
+    };
+
+    /**
+     * @brief Returns the index of the source of a packet, declaring it first if it is new or its name changed
+     *
+     */
+    uint16_t sourceIndex(const sACNPacket& packet, uint64_t timestamp)
+    {
+        const sacn_packet_struct* packed = packet.getPackedPacket();
+        sACNCID cid = packet.cid();
+
+        std::map<sACNCID, uint16_t>::iterator it = m_sourceIndices.find(cid);
+        uint16_t index;
+        if(it == m_sourceIndices.end())
+        {
+            index = static_cast<uint16_t>(m_sourceNames.size());
+            m_sourceIndices[cid] = index;
+            m_sourceNames.emplace_back();
+        }
+        else
+        {
+            index = it->second;
+        }
+
+        // synchronization packets carry no name, data packets may carry an unterminated one
+        if(packet.isSyncPacket())
+        {
+            if(it == m_sourceIndices.end())
+                declareSource(timestamp, index, cid, std::string());
+            return index;
+        }
+
+        const char* name = (const char*)packed->frame.source_name;
+        std::string sourceName(name, strnlen(name, sizeof(packed->frame.source_name)));
+        if(it == m_sourceIndices.end() || m_sourceNames[index] != sourceName)
+        {
+            m_sourceNames[index] = sourceName;
+            declareSource(timestamp, index, cid, sourceName);
+        }
+        return index;
+    }
+
+    /**
+     * @brief Appends a Source record
+     *
+     */
+    void declareSource(uint64_t timestamp, uint16_t index, const sACNCID& cid, const std::string& name)
+    {
+        m_record.resize(sACNCaptureFormat::recordHeaderSize);
+        m_record.insert(m_record.end(), cid.begin(), cid.end());
+        m_record.insert(m_record.end(), name.begin(), name.end());
+        writeHeader(timestamp, sACNCaptureRecordType::Source, index, 0, 0, 0, 0, 0, 0, 0);
+        append();
+    }
+
+    /**
+     * @brief Appends the runs of changed slots to m_record, if they are smaller than all slots
+     *
+     * @return true: the delta was appended
+     * @return false: the delta would not be smaller, m_record is unchanged
+     */
+    bool encodeDelta(const uint8_t* previous, const uint8_t* current, uint16_t slots)
+    {
+        size_t start = m_record.size();
+        uint16_t i = 0;
+        while(i < slots)
+        {
+            if(previous[i] == current[i])
+            {
+                i++;
+                continue;
+            }
+
+            // a run ends at 4 equal slots in a row, as a new run costs 4 bytes of offset and length
+            uint16_t first = i;
+            uint16_t last = i;
+            for(i++; i < slots && i - last <= 4; i++)
+            {
+                if(previous[i] != current[i])
+                    last = i;
+            }
+            i = last + 1;
+
+            uint16_t length = last + 1 - first;
+            if(m_record.size() - start + 4 + length >= slots)
+            {
+                m_record.resize(start);
+                return false;
+            }
+
+            uint8_t run[4];
+            sACNCaptureFormat::put16(run, first);
+            sACNCaptureFormat::put16(run + 2, length);
+            m_record.insert(m_record.end(), run, run + 4);
+            m_record.insert(m_record.end(), current + first, current + last + 1);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Fills the header at the start of m_record, the payload has to be appended already
+     *
+     */
+    void writeHeader(uint64_t timestamp, sACNCaptureRecordType type, uint16_t source, uint16_t universe, uint8_t priority,
+        uint8_t sequence, uint8_t options, uint8_t startCode, uint16_t syncAddress, uint16_t slots)
+    {
+        uint8_t* header = m_record.data();
+        sACNCaptureFormat::put64(header, timestamp);
+        header[8] = static_cast<uint8_t>(type);
+        sACNCaptureFormat::put16(header + 9, source);
+        sACNCaptureFormat::put16(header + 11, universe);
+        header[13] = priority;
+        header[14] = sequence;
+        header[15] = options;
+        header[16] = startCode;
+        sACNCaptureFormat::put16(header + 17, syncAddress);
+        sACNCaptureFormat::put16(header + 19, slots);
+        sACNCaptureFormat::put16(header + 21, static_cast<uint16_t>(m_record.size() - sACNCaptureFormat::recordHeaderSize));
+    }
+
+    /**
+     * @brief Appends m_record to the file
+     *
+     */
+    bool append()
+    {
+        m_file.write((const char*)m_record.data(), m_record.size());
+        m_bytes += m_record.size();
+        return static_cast<bool>(m_file);
+    }
+
+    /**
+     * @brief A mutex protecting all members, packets may be written by several receive workers
+     *
+     */
+    std::mutex m_mutex;
+
+    /**
+     * @brief the buffer of m_file
+     *
+     */
+    std::vector<char> m_buffer;
+
+    /**
+     * @brief the capture file
+     *
+     */
+    std::ofstream m_file;
+
+    /**
+     * @brief the time the capture started, the timestamps are relative to it
+     *
+     */
+    std::chrono::steady_clock::time_point m_start;
+
+    /**
+     * @brief the index of every source declared, by CID
+     *
+     */
+    std::map<sACNCID, uint16_t> m_sourceIndices;
+
+    /**
+     * @brief the name last declared of every source, by index
+     *
+     */
+    std::vector<std::string> m_sourceNames;
+
+    /**
+     * @brief the previous packet of every stream, by sACNCaptureFormat::streamKey()
+     *
+     */
+    std::unordered_map<uint64_t, Frame> m_frames;
+
+    /**
+     * @brief the record being encoded
+     *
+     */
+    std::vector<uint8_t> m_record;
+
+    /**
+     * @brief the number of packets appended
+     *
+     */
+    uint64_t m_packets = 0;
+
+    /**
+     * @brief the size of the capture
+     *
+     */
+    uint64_t m_bytes = 0;
+};
+
+/**
+ * @brief Reads the records of a capture file sequentially from a read only memory mapping of the file,
+ * so captures larger than the memory can be read. The records are not copied, their payload points into the mapping.
+ *
+ */
+class sACNCaptureReader
+{
+public:
+
+    /**
+     * @brief Maps a capture file and checks its header
+     *
+     * @throw std::runtime_error if the file could not be mapped or is no capture file
+     * @param path the path of the file
+     */
+    sACNCaptureReader(const std::string& path)
+    {
+        map(path);
+
+        if(m_size < sACNCaptureFormat::headerSize || memcmp(m_data, sACNCaptureFormat::magic, sizeof(sACNCaptureFormat::magic)) != 0)
+        {
+            unmap();
+            throw std::runtime_error(path + " is no capture file.");
+        }
+        if(sACNCaptureFormat::get32(m_data + 8) != sACNCaptureFormat::version)
+        {
+            unmap();
+            throw std::runtime_error(path + " has an unsupported capture version.");
+        }
+
+        m_position = sACNCaptureFormat::headerSize;
+    }
+
+    sACNCaptureReader(const sACNCaptureReader&) = delete;
+    sACNCaptureReader& operator=(const sACNCaptureReader&) = delete;
+
+    /**
+     * @brief Destroy the sACNCaptureReader object and unmaps the file
+     *
+     */
+    ~sACNCaptureReader()
+    {
+        unmap();
+    }
+
+    /**
+     * @brief Reads the next record
+     *
+     * @param record receives the record, its payload stays valid as long as the reader
+     * @return true: a record was read
+     * @return false: the end of the file was reached. A record cut off at the end, e.g. because the capturing
+     * process was killed, is treated as the end.
+     */
+    bool next(sACNCaptureRecord& record)
+    {
+        if(m_size - m_position < sACNCaptureFormat::recordHeaderSize)
+            return false;
+
+        const uint8_t* header = m_data + m_position;
+        uint16_t payloadLength = sACNCaptureFormat::get16(header + 21);
+        if(m_size - m_position - sACNCaptureFormat::recordHeaderSize < payloadLength)
+            return false;
+
+        record.timestamp = sACNCaptureFormat::get64(header);
+        record.type = static_cast<sACNCaptureRecordType>(header[8]);
+        record.source = sACNCaptureFormat::get16(header + 9);
+        record.universe = sACNCaptureFormat::get16(header + 11);
+        record.priority = header[13];
+        record.sequence = header[14];
+        record.options = header[15];
+        record.startCode = header[16];
+        record.syncAddress = sACNCaptureFormat::get16(header + 17);
+        record.slots = sACNCaptureFormat::get16(header + 19);
+        record.payloadLength = payloadLength;
+        record.payload = header + sACNCaptureFormat::recordHeaderSize;
+
+        m_position += sACNCaptureFormat::recordHeaderSize + payloadLength;
+        return true;
+    }
+
+    /**
+     * @brief Continues reading at the first record
+     *
+     */
+    void rewind()
+    {
+        m_position = sACNCaptureFormat::headerSize;
+    }
+
+    /**
+     * @brief the wall clock time the capture started
+     *
+     */
+    std::chrono::system_clock::time_point started() const
+    {
+        return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::nanoseconds(static_cast<int64_t>(sACNCaptureFormat::get64(m_data + 16)))));
+    }
+
+    /**
+     * @brief the size of the file in bytes
+     *
+     */
+    uint64_t size() const
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief the offset of the next record in the file
+     *
+     */
+    uint64_t position() const
+    {
+        return m_position;
+    }
+
+private:
+
+#ifdef _WIN32
+    void map(const std::string& path)
+    {
+        m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        LARGE_INTEGER size;
+        if(m_fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_fileHandle, &size))
+        {
+            unmap();
+            throw std::runtime_error("Could not open the capture file " + path + ".");
+        }
+        m_size = size.QuadPart;
+        if(m_size == 0)
+            return;
+
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(m_mappingHandle != nullptr)
+            m_data = (const uint8_t*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if(m_data == nullptr)
+        {
+            unmap();
+            throw std::runtime_error("Could not map the capture file " + path + ".");
+        }
+    }
+
+    void unmap()
+    {
+        if(m_data != nullptr)
+            UnmapViewOfFile(m_data);
+        if(m_mappingHandle != nullptr)
+            CloseHandle(m_mappingHandle);
+        if(m_fileHandle != INVALID_HANDLE_VALUE)
+            CloseHandle(m_fileHandle);
+        m_data = nullptr;
+        m_mappingHandle = nullptr;
+        m_fileHandle = INVALID_HANDLE_VALUE;
+    }
+
+    /**
+     * @brief the handle of the file
+     *
+     */
+    HANDLE m_fileHandle = INVALID_HANDLE_VALUE;
+
+    /**
+     * @brief the handle of the mapping
+     *
+     */
+    HANDLE m_mappingHandle = nullptr;
+#else
+    void map(const std::string& path)
+    {
+        int file = open(path.c_str(), O_RDONLY);
+        struct stat status;
+        if(file < 0 || fstat(file, &status) != 0)
+        {
+            if(file >= 0)
+                ::close(file);
+            throw std::runtime_error("Could not open the capture file " + path + ".");
+        }
+        m_size = status.st_size;
+        if(m_size == 0)
+        {
+            ::close(file);
+            return;
+        }
+
+        // the mapping keeps the file referenced, the descriptor is not needed anymore
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if(data == MAP_FAILED)
+            throw std::runtime_error("Could not map the capture file " + path + ".");
+
+        // the pages are read once in order, so the kernel can read ahead and drop them early
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = (const uint8_t*)data;
+    }
+
+    void unmap()
+    {
+        if(m_data != nullptr)
+            munmap((void*)m_data, m_size);
+        m_data = nullptr;
+    }
+#endif
+
+    /**
+     * @brief the mapped file
+     *
+     */
+    const uint8_t* m_data = nullptr;
+
+    /**
+     * @brief the size of the file
+     *
+     */
+    uint64_t m_size = 0;
+
+    /**
+     * @brief the offset of the next record
+     *
+     */
+    uint64_t m_position = 0;
+};
+
+/**
+ * @brief Turns the records of a capture back into sACN packets, keeping the previous packet of every stream
+ * to apply delta records to
+ *
+ */
+class sACNCaptureDecoder
+{
+public:
+
+    /**
+     * @brief Applies a record
+     *
+     * @throw std::runtime_error if the record refers to a source that was not declared, or is a delta
+     * without a previous packet of its stream
+     * @param record the record read
+     * @return const sACNPacket* the packet of a Data, Delta or Sync record, valid until the next call.
+     * nullptr for Source records and records of unknown types.
+     */
+    const sACNPacket* decode(const sACNCaptureRecord& record)
+    {
+        switch(record.type)
+        {
+            case sACNCaptureRecordType::Source:
+                declareSource(record);
+                return nullptr;
+            case sACNCaptureRecordType::Sync:
+                return decodeSync(record);
+            case sACNCaptureRecordType::Data:
+            case sACNCaptureRecordType::Delta:
+                return decodeData(record);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Forgets all sources and streams, to decode a capture from its start again
+     *
+     */
+    void reset()
+    {
+        m_sources.clear();
+        m_streams.clear();
+    }
+
+private:
+
+    /**
+     * @brief A source declared by a Source record
+     *
+     */
+    struct Source
+    {
+        sACNCID cid;
+        std::string name;
+    };
+
+    void declareSource(const sACNCaptureRecord& record)
+    {
+        if(record.payloadLength < 16)
+            throw std::runtime_error("Invalid source record in the capture.");
+
+        if(record.source >= m_sources.size())
+            m_sources.resize(record.source + 1);
+
+        Source& source = m_sources[record.source];
+        memcpy(source.cid.data(), record.payload, 16);
+        source.name.assign((const char*)record.payload + 16, std::min<size_t>(record.payloadLength - 16, 62));
+    }
+
+    const Source& source(const sACNCaptureRecord& record) const
+    {
+        if(record.source >= m_sources.size())
+            throw std::runtime_error("The capture refers to a source that was not declared.");
+        return m_sources[record.source];
+    }
+
+    const sACNPacket* decodeSync(const sACNCaptureRecord& record)
+    {
+        m_sync = sACNPacket::syncPacket(record.universe);
+        m_sync.setCID(source(record).cid);
+        m_sync.setSequenceNumber(record.sequence);
+        return &m_sync;
+    }
+
+    const sACNPacket* decodeData(const sACNCaptureRecord& record)
+    {
+        const Source& sender = source(record);
+        uint64_t key = sACNCaptureFormat::streamKey(record.source, record.universe, record.startCode);
+        std::unordered_map<uint64_t, sACNPacket>::iterator it = m_streams.find(key);
+
+        if(record.type == sACNCaptureRecordType::Delta)
+        {
+            if(it == m_streams.end() || it->second.numDMXSlots() != record.slots)
+                throw std::runtime_error("The capture holds a delta without a previous packet.");
+            applyDelta(it->second.slotData(), record);
+        }
+        else
+        {
+            if(it == m_streams.end())
+                it = m_streams.emplace(key, sACNPacket(record.universe)).first;
+
+            uint16_t slots = std::min<uint16_t>(std::min<uint16_t>(record.slots, record.payloadLength), 512);
+            it->second.setNumDMXSlots(slots);
+            memcpy(it->second.slotData(), record.payload, slots);
+        }
+
+        sACNPacket& packet = it->second;
+        packet.setCID(sender.cid);
+        packet.setSourceName(sender.name);
+        packet.setPriority(record.priority);
+        packet.setSequenceNumber(record.sequence);
+        packet.getPackedPacket()->frame.options = record.options;
+        packet.setStartCode(record.startCode);
+        if(record.syncAddress <= 63999)
+            packet.setSyncAddress(record.syncAddress);
+        return &packet;
+    }
+
+    static void applyDelta(uint8_t* slots, const sACNCaptureRecord& record)
+    {
+        uint16_t position = 0;
+        while(position + 4 <= record.payloadLength)
+        {
+            uint16_t offset = sACNCaptureFormat::get16(record.payload + position);
+            uint16_t length = sACNCaptureFormat::get16(record.payload + position + 2);
+            position += 4;
+
+            if(length > record.payloadLength - position || offset + length > record.slots)
+                throw std::runtime_error("Invalid delta record in the capture.");
+
+            memcpy(slots + offset, record.payload + position, length);
+            position += length;
+        }
+    }
+
+    /**
+     * @brief the sources declared, by index
+     *
+     */
+    std::vector<Source> m_sources;
+
+    /**
+     * @brief the previous packet of every stream, by sACNCaptureFormat::streamKey()
+     *
+     */
+    std::unordered_map<uint64_t, sACNPacket> m_streams;
+
+    /**
+     * @brief the packet of the last Sync record
+     *
+     */
+    sACNPacket m_sync;
+};
+
+}
@@ -0,0 +1,245 @@
+#pragma once
+#include <stdint.h>
+#include <asio_standalone_or_boost.hpp>
+#include <sacn_capture.hpp>
+#include <sacn_sender_socket.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sACNcpp {
+
+/**
+ * @brief Sends the packets of a capture file again, see sACNCaptureWriter.
+ *
+ * The file is memory mapped and read sequentially, so captures larger than the memory can be played.
+ * The packets are sent with the intervals they were received with, divided by a speed factor, or as fast
+ * as possible. Packets that are due at the same time are sent together with sACNSenderSocket::sendPacketsMulticast().
+ *
+ */
+class sACNCapturePlayer
+{
+public:
+
+    /**
+     * @brief Construct a new sACNCapturePlayer object and maps the capture file
+     *
+     * @throw std::runtime_error if the file could not be mapped or is no capture file
+     * @param path the path of the capture file
+     * @param io_context the asio iocontext object to use for the underlying socket, optional
+     */
+    sACNCapturePlayer(const std::string& path, std::shared_ptr<asio::io_context> io_context = nullptr) :
+        m_reader(path),
+        m_iocontext(io_context)
+    {
+        if(!m_iocontext)
+            m_iocontext = std::make_shared<asio::io_context>();
+    }
+
+    /**
+     * @brief Opens the socket to send with
+     *
+     * @param networkInterface The network interface to use. If none is provided, some interface/the default will be chosen.
+     * @return true: creation of the socket was successful
+     * @return false: there was an error constructing the socket
+     */
+    bool start(std::string networkInterface = "")
+    {
+        m_socket = std::make_unique<sACNSenderSocket>(m_iocontext, networkInterface);
+        if(m_socket->start())
+            return true;
+
+        m_socket.reset();
+        return false;
+    }
+
+    /**
+     * @brief Sends all packets of the capture, from its start. Blocks until all were sent or stop() was called.
+     *
+     * @throw std::logic_error if start() did not succeed
+     * @throw std::invalid_argument if speed is negative
+     * @throw std::runtime_error if the capture is corrupt
+     * @param speed the intervals between the packets are divided by speed, 0 sends as fast as possible
+     * @param unicastHost if not empty, the packets are sent to this host instead of their multicast groups
+     * @return uint64_t the number of packets sent
+     */
+    uint64_t play(double speed = 1.0, const std::string& unicastHost = "")
+    {
+        if(!m_socket)
+            throw std::logic_error("The socket of the player has to be started before playing.");
+        if(speed < 0)
+            throw std::invalid_argument("The speed has to be 0 or greater.");
+
+        m_stopped.store(false);
+        m_reader.rewind();
+        m_decoder.reset();
+
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        uint64_t sent = 0;
+        sACNCaptureRecord record;
+
+        while(!m_stopped.load(std::memory_order_relaxed) && m_reader.next(record))
+        {
+            const sACNPacket* packet = m_decoder.decode(record);
+            if(packet == nullptr)
+                continue;
+
+            if(speed > 0)
+            {
+                std::chrono::steady_clock::time_point due = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::nano>(record.timestamp / speed));
+
+                if(due > std::chrono::steady_clock::now())
+                {
+                    sent += send(unicastHost);
+                    wait(due);
+                }
+            }
+
+            // the decoder reuses its packets, so the batch holds copies
+            m_batch[m_batchSize++] = *packet;
+            if(m_batchSize == m_batch.size())
+                sent += send(unicastHost);
+        }
+
+        sent += send(unicastHost);
+        m_packetsSent.fetch_add(sent, std::memory_order_relaxed);
+        return sent;
+    }
+
+    /**
+     * @brief Makes a running play() return after the packet it is sending. May be called from any thread.
+     *
+     */
+    void stop()
+    {
+        m_stopped.store(true);
+    }
+
+    /**
+     * @brief the number of packets sent by all calls to play() that returned
+     *
+     */
+    uint64_t packetsSent() const
+    {
+        return m_packetsSent.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief the reader of the capture file, e.g. to show the progress while playing
+     *
+     */
+    const sACNCaptureReader& reader() const
+    {
+        return m_reader;
+    }
+
+private:
+
+    /**
+     * @brief Sleeps until a packet is due, in slices so that stop() is noticed during long pauses of the capture
+     *
+     */
+    void wait(std::chrono::steady_clock::time_point due)
+    {
+        while(!m_stopped.load(std::memory_order_relaxed))
+        {
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if(now >= due)
+                return;
+            std::this_thread::sleep_until(std::min(due, now + std::chrono::milliseconds(100)));
+        }
+    }
+
+    /**
+     * @brief Sends the batched packets
+     *
+     * @return size_t the number of packets sent successfully
+     */
+    size_t send(const std::string& unicastHost)
+    {
+        size_t sent = 0;
+        if(m_batchSize == 0)
+            return sent;
+
+        if(unicastHost.empty())
+        {
+            m_pointers.clear();
+            for(size_t i = 0; i < m_batchSize; i++)
+                m_pointers.push_back(&m_batch[i]);
+            sent = m_socket->sendPacketsMulticast(m_pointers).sent;
+        }
+        else
+        {
+            for(size_t i = 0; i < m_batchSize; i++)
+            {
+                if(m_socket->sendPacketUnicast(m_batch[i], unicastHost))
+                    sent++;
+            }
+        }
+
+        m_batchSize = 0;
+        return sent;
+    }
+
+    /**
+     * @brief the reader of the capture file
+     *
+     */
+    sACNCaptureReader m_reader;
+
+    /**
+     * @brief the decoder turning the records back into packets
+     *
+     */
+    sACNCaptureDecoder m_decoder;
+
+    /**
+     * @brief the asio context of the socket
+     *
+     */
+    std::shared_ptr<asio::io_context> m_iocontext;
+
+    /**
+     * @brief the socket sent with
+     *
+     */
+    std::unique_ptr<sACNSenderSocket> m_socket;
+
+    /**
+     * @brief the packets due, not sent yet
+     *
+     */
+    std::array<sACNPacket, 64> m_batch;
+
+    /**
+     * @brief the number of packets in m_batch
+     *
+     */
+    size_t m_batchSize = 0;
+
+    /**
+     * @brief pointers to the packets of m_batch, for sendPacketsMulticast()
+     *
+     */
+    std::vector<const sACNPacket*> m_pointers;
+
+    /**
+     * @brief true when play() should return
+     *
+     */
+    std::atomic<bool> m_stopped{false};
+
+    /**
+     * @brief the number of packets sent
+     *
+     */
+    std::atomic<uint64_t> m_packetsSent{0};
+};
+
+}
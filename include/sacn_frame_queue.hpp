@@ -0,0 +1,270 @@
+#pragma once
+#include <stdint.h>
+#include <sacn_packet.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <stdexcept>
+
+namespace sACNcpp {
+
+/**
+ * @brief A DMX frame received from a source
+ *
+ */
+struct sACNFrame
+{
+    /**
+     * @brief the universe of the frame
+     *
+     */
+    uint16_t universe = 0;
+
+    /**
+     * @brief the Component Identifier of the source that sent the frame
+     *
+     */
+    sACNCID cid{};
+
+    /**
+     * @brief the universe priority of the source
+     *
+     */
+    uint8_t priority = 0;
+
+    /**
+     * @brief the sequence number of the packet
+     *
+     */
+    uint8_t sequence = 0;
+
+    /**
+     * @brief the number of DMX slots in data
+     *
+     */
+    uint16_t slots = 0;
+
+    /**
+     * @brief the time the packet was received
+     *
+     */
+    std::chrono::steady_clock::time_point received;
+
+    /**
+     * @brief the DMX values, the slots behind slots are undefined
+     *
+     */
+    std::array<uint8_t, 512> data;
+};
+
+/**
+ * @brief What sACNFrameQueue does when a frame is pushed to the full queue
+ *
+ */
+enum class sACNOverflowPolicy
+{
+    /**
+     * @brief the oldest frame in the queue is dropped to make room for the new one
+     *
+     */
+    DropOldest,
+
+    /**
+     * @brief the new frame is dropped
+     *
+     */
+    DropNewest
+};
+
+/**
+ * @brief A fixed capacity ring buffer passing sACNFrames from one producer thread to one consumer thread.
+ *
+ * All frames are allocated when the queue is constructed, pushing and popping never allocate or lock.
+ * push() and pushInPlace() are wait-free. pop() is wait-free with sACNOverflowPolicy::DropNewest; with DropOldest
+ * it retries when the producer drops the frame it is reading, which only happens while the queue is full.
+ * Frames dropped by either policy are counted by overflows().
+ *
+ */
+class sACNFrameQueue
+{
+public:
+
+    /**
+     * @brief Construct a new sACNFrameQueue object and allocates all frames
+     *
+     * @throw std::invalid_argument if capacity is 0
+     * @param capacity the number of frames the queue holds, rounded up to a power of two
+     * @param policy what to do when a frame is pushed to the full queue
+     */
+    sACNFrameQueue(size_t capacity, sACNOverflowPolicy policy = sACNOverflowPolicy::DropOldest) :
+        m_policy(policy)
+    {
+        if(capacity == 0)
+            throw std::invalid_argument("The capacity of the frame queue has to be greater than 0.");
+
+        size_t size = 1;
+        while(size < capacity)
+            size *= 2;
+
+        m_frames.resize(size);
+        m_mask = size - 1;
+    }
+
+    sACNFrameQueue(const sACNFrameQueue&) = delete;
+    sACNFrameQueue& operator=(const sACNFrameQueue&) = delete;
+
+    /**
+     * @brief Adds a frame, filled in place by a callable. Must only be called by the producer thread.
+     *
+     * @param fill a callable taking sACNFrame&, writing the new frame
+     * @return true: the frame was added
+     * @return false: the queue was full and the policy is DropNewest, fill was not called
+     */
+    template<typename F>
+    bool pushInPlace(F&& fill)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+        if(head - tail > m_mask)
+        {
+            if(m_policy == sACNOverflowPolicy::DropNewest)
+            {
+                m_overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // if the consumer took the oldest frame in the meantime, there is room without dropping
+            if(m_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel))
+                m_overflows.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        fill(m_frames[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Adds a copy of a frame. Must only be called by the producer thread.
+     *
+     * @return true: the frame was added
+     * @return false: the queue was full and the policy is DropNewest
+     */
+    bool push(const sACNFrame& frame)
+    {
+        return pushInPlace([&frame](sACNFrame& slot) { slot = frame; });
+    }
+
+    /**
+     * @brief Takes the oldest frame. Must only be called by the consumer thread.
+     *
+     * @param frame receives the frame
+     * @return true: a frame was taken
+     * @return false: the queue is empty, frame is undefined
+     */
+    bool pop(sACNFrame& frame)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        while(true)
+        {
+            if(tail == m_head.load(std::memory_order_acquire))
+                return false;
+
+            frame = m_frames[tail & m_mask];
+
+            // fails if the producer dropped the frame while it was copied, the copy may be torn then
+            if(m_tail.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel))
+                return true;
+        }
+    }
+
+    /**
+     * @brief the number of frames currently in the queue
+     *
+     */
+    size_t size() const
+    {
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+        return m_head.load(std::memory_order_acquire) - tail;
+    }
+
+    /**
+     * @brief the number of frames the queue holds
+     *
+     */
+    size_t capacity() const
+    {
+        return m_frames.size();
+    }
+
+    /**
+     * @brief the policy applied when the queue is full
+     *
+     */
+    sACNOverflowPolicy policy() const
+    {
+        return m_policy;
+    }
+
+    /**
+     * @brief the number of frames dropped because the queue was full
+     *
+     */
+    uint64_t overflows() const
+    {
+        return m_overflows.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    /**
+     * @brief the storage of all frames
+     *
+     */
+    std::vector<sACNFrame> m_frames;
+
+    /**
+     * @brief capacity - 1, to map the indices to m_frames
+     *
+     */
+    uint64_t m_mask;
+
+    /**
+     * @brief the policy applied when the queue is full
+     *
+     */
+    sACNOverflowPolicy m_policy;
+
+    /**
+     * @brief keeps m_head on another cache line than the members read by both threads
+     *
+     */
+    char m_headPadding[64];
+
+    /**
+     * @brief the index of the next frame pushed, only written by the producer
+     *
+     */
+    std::atomic<uint64_t> m_head{0};
+
+    /**
+     * @brief keeps m_tail on another cache line than m_head
+     *
+     */
+    char m_tailPadding[64];
+
+    /**
+     * @brief the index of the oldest frame, written by the consumer and, when dropping the oldest frame, the producer
+     *
+     */
+    std::atomic<uint64_t> m_tail{0};
+
+    /**
+     * @brief the number of frames dropped
+     *
+     */
+    std::atomic<uint64_t> m_overflows{0};
+};
+
+}
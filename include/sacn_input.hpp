@@ -3,13 +3,25 @@
 #include <asio_standalone_or_boost.hpp>
 #include <sacn_receiver_socket.hpp>
 #include <sacn_universe_input.hpp>
+#include <sacn_packet_pool.hpp>
+#include <sacn_packet_view.hpp>
+#include <sacn_universe_table.hpp>
+#include <sacn_metrics.hpp>
+#include <sacn_capture.hpp>
 #include <atomic>
 #include <thread>
 #include <memory>
 #include <chrono>
+#include <future>
 #include <array>
-#include <set>
-#include <shared_mutex>
+#include <vector>
+#include <mutex>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace sACNcpp {
 
@@ -17,7 +29,21 @@ namespace sACNcpp {
  * @brief A class receiving all dmx data from sACN.
  * 
  * A separate thread is used in the background.
- * sACN is only received (and the DMXUniverseData accessible by dmx() filled) when start() was called. 
+ * sACN is only received (and the DMXUniverseData accessible by dmx() filled) when start() or startAsync() was called. 
+ * 
+ * To spread the receive load over several cores, multiple receive workers can be used. Each worker has its own 
+ * socket bound to the sACN port with SO_REUSEPORT and its own thread. Every universe is joined by exactly one 
+ * worker (universe % workers), so its multicast traffic arrives on that worker, while unicast traffic is distributed 
+ * by the kernel. The universes are safe to update from several workers at once.
+ * 
+ * Universe synchronization is handled transparently: data of universes sent with a synchronization address is 
+ * staged, and published for all universes of the synchronization address at once when the synchronization 
+ * packet arrives. As long as no synchronization packet was received for E131_NETWORK_DATA_LOSS_TIMEOUT, 
+ * the data is published immediately.
+ * 
+ * Packets, bytes and invalid packets are counted per universe in a sACNMetricsRegistry, which also collects the 
+ * sequence statistics of the universes and the timing of the receive workers when a snapshot is taken.
+ * All valid packets can be recorded to a capture file with setCapture(), to be played again by sACNCapturePlayer.
  * 
  */
 class sACNInput {
@@ -27,13 +53,38 @@ public:
     /**
      * @brief Construct a new sACNInput object.
      * 
-     * @param io_context the asio iocontext object to use for the underlying socket (optional)
+     * @param io_context the asio iocontext object to use for the underlying sockets (optional)
+     * @param receiveBatchSize the maximum number of packets fetched from a socket at once
+     * @param receiveWorkers the number of sockets and threads receiving in parallel, at least 1
+     * @param pinWorkers if true, the thread of worker i is pinned to core i (modulo the number of cores). Only supported on linux.
      */
-    sACNInput(std::shared_ptr<asio::io_context> io_context=nullptr) : m_iocontext(io_context)
+    sACNInput(std::shared_ptr<asio::io_context> io_context=nullptr, size_t receiveBatchSize=64, 
+        size_t receiveWorkers=1, bool pinWorkers=false) : 
+        m_receiveBatchSize(receiveBatchSize),
+        m_pinWorkers(pinWorkers),
+        m_packetPool(receiveBatchSize * std::max<size_t>(receiveWorkers, 1)),
+        m_iocontext(io_context),
+        m_ownsContext(!io_context)
     {
+        for(size_t i = 0; i < std::max<size_t>(receiveWorkers, 1); i++)
+        {
+            std::unique_ptr<ReceiveWorker> worker = std::make_unique<ReceiveWorker>();
+            worker->index = i;
+            worker->receiveLengths.resize(m_receiveBatchSize);
+            for(size_t j = 0; j < m_receiveBatchSize; j++)
+            {
+                worker->receivePackets.push_back(m_packetPool.acquire());
+                worker->receiveBuffers.push_back(worker->receivePackets.back().get());
+            }
+            m_workers.push_back(std::move(worker));
+        }
+
         if(!m_iocontext)
             m_iocontext = std::make_unique<asio::io_context>();
         m_running.store(false);
+
+        m_metrics = std::make_shared<sACNMetricsRegistry>();
+        m_collector = m_metrics->addCollector([this](sACNMetricsSnapshot& snapshot) { this->collectMetrics(snapshot); });
     }
 
     /**
@@ -43,26 +94,139 @@ public:
     ~sACNInput()
     {
         stop();
+        m_metrics->removeCollector(m_collector);
+    }
+
+    /**
+     * @brief Returns the registry the metrics of this input are collected in
+     * 
+     * @return std::shared_ptr<sACNMetricsRegistry> 
+     */
+    std::shared_ptr<sACNMetricsRegistry> metrics() const
+    {
+        return m_metrics;
     }
 
     /**
-     * @brief Starts execution of the receiver. This will spawn an additional thread to receive sACN in the background.
+     * @brief Sets the registry the metrics of this input are collected in, e.g. to share one registry with a sACNOutput. 
+     * The counters of the universes start at zero in the new registry.
+     * 
+     * @throw std::invalid_argument exception if registry is empty
+     * @throw std::logic_error exception if the input is running
+     * @param registry the registry to use
+     */
+    void setMetricsRegistry(std::shared_ptr<sACNMetricsRegistry> registry)
+    {
+        if(!registry)
+            throw std::invalid_argument("The metrics registry must not be empty.");
+        if(m_running.load())
+            throw std::logic_error("The metrics registry can only be changed while the input is stopped.");
+
+        m_metrics->removeCollector(m_collector);
+        m_metrics = std::move(registry);
+        m_universes.forEach([this](uint16_t universe, sACNUniverseInput& input) { 
+            input.setMetrics(&m_metrics->universe(universe)); 
+        });
+        m_collector = m_metrics->addCollector([this](sACNMetricsSnapshot& snapshot) { this->collectMetrics(snapshot); });
+    }
+
+    /**
+     * @brief Sets the capture every valid packet received is written to, including the packets of universes 
+     * that were not added, e.g. when they arrive by unicast. See sACNCaptureWriter.
+     * 
+     * @throw std::logic_error exception if the input is running
+     * @param capture the capture, or nullptr to stop capturing
+     */
+    void setCapture(std::shared_ptr<sACNCaptureWriter> capture)
+    {
+        if(m_running.load())
+            throw std::logic_error("The capture can only be changed while the input is stopped.");
+
+        m_capture = std::move(capture);
+    }
+
+    /**
+     * @brief Returns the capture packets are written to, if any
+     * 
+     * @return std::shared_ptr<sACNCaptureWriter> 
+     */
+    std::shared_ptr<sACNCaptureWriter> capture() const
+    {
+        return m_capture;
+    }
+
+    /**
+     * @brief Starts execution of the receiver. This will spawn an additional thread per receive worker, 
+     * polling its socket to receive sACN in the background.
      * @param networkInterface the network interface to bind to. if empty, the default interface will be chosen
-     * @return true: creation of the socket was successful
-     * @return false: there was an error constructing the socket
+     * @return true: creation of the sockets was successful
+     * @return false: there was an error constructing the sockets
      */
     bool start(std::string networkInterface="")
     {
         if(m_running.load())
             return false;
 
-        m_socket = std::make_unique<sACNReceiverSocket>(m_iocontext, networkInterface);
+        if(!openSockets(networkInterface))
+            return false;
+
+        m_async = false;
+        m_running.store(true);
+        for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+        {
+            ReceiveWorker* receiveWorker = worker.get();
+            worker->thread = std::thread([this, receiveWorker]() { this->run(*receiveWorker); });
+            pinThread(worker->thread, worker->index);
+        }
+
+        return true;
+    }
 
-        if(!m_socket->start())
+    /**
+     * @brief Starts execution of the receiver in asynchronous mode. Instead of polling the socket, 
+     * packets are handled as soon as they arrive, from a thread running the io_context. 
+     * 
+     * @param networkInterface the network interface to bind to. if empty, the default interface will be chosen
+     * @param runContext if true, an additional thread per receive worker is spawned to run the io_context. If false, the 
+     * io_context (passed to the constructor) has to be run by the user, and has to keep running until stop() returned.
+     * An io_context passed to the constructor is never stopped or restarted, it may be run by other threads as well.
+     * @return true: creation of the sockets was successful
+     * @return false: there was an error constructing the sockets
+     */
+    bool startAsync(std::string networkInterface="", bool runContext=true)
+    {
+        if(m_running.load())
+            return false;
+
+        if(!openSockets(networkInterface))
             return false;
 
+        m_async = true;
+        m_runContext = runContext;
         m_running.store(true);
-        m_thread = std::thread([this]() {this->run(); });
+
+        for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+        {
+            ReceiveWorker* receiveWorker = worker.get();
+            worker->socket->startAsyncReceive(worker->receiveBuffers.data(), worker->receiveLengths.data(), m_receiveBatchSize, 
+                [this, receiveWorker](size_t received) { this->handlePackets(*receiveWorker, received); });
+        }
+
+        if(m_runContext)
+        {
+            // only a context created here was stopped by stop(), a shared one is left to its owner
+            if(m_ownsContext)
+                m_iocontext->restart();
+
+            // keeps the threads running while no wait is pending
+            m_workGuard = std::make_unique<asio::executor_work_guard<asio::io_context::executor_type>>(m_iocontext->get_executor());
+            m_contextThreadsRunning.store(true);
+            for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+            {
+                worker->thread = std::thread([this]() { this->runIOContext(); });
+                pinThread(worker->thread, worker->index);
+            }
+        }
 
         return true;
     }
@@ -77,35 +241,123 @@ public:
             return;
 
         m_running.store(false);
-        m_thread.join();
+
+        if(m_async)
+        {
+            for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+            {
+                std::future<void> finished = worker->socket->stopAsyncReceive();
+
+                if(!m_iocontext->stopped())
+                    finished.wait();
+            }
+
+            if(m_runContext)
+            {
+                m_contextThreadsRunning.store(false);
+                m_workGuard.reset();
+                if(m_ownsContext)
+                    m_iocontext->stop();
+                for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+                    worker->thread.join();
+            }
+        }
+        else
+        {
+            for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+                worker->thread.join();
+        }
+    }
+
+    /**
+     * @brief the number of receive workers
+     * 
+     * @return size_t 
+     */
+    size_t receiveWorkers() const
+    {
+        return m_workers.size();
     }
 
     /**
      * @brief Adds a universe to listen to. This will join the corresponding multicast group.
      * 
      * @param universe the universe to listen to
+     * @param synchronization how concurrent access to the DMXUniverseData of the universe is synchronized
+     * @param mergeMode how the data of several sources with the same priority is combined
      * @return true: creation of the socket receiver was successful
      * @return false: there was an error joining the multicast group, or the universe was already registered
      */
-    bool addUniverse(const uint16_t& universe)
+    bool addUniverse(const uint16_t& universe, 
+        DMXSynchronization synchronization=DMXSynchronization::Mutex, 
+        DMXMergeMode mergeMode=DMXMergeMode::HTP)
     {
         if(hasUniverse(universe))
             return false;
 
-        if(!m_socket->joinUniverse(universe))
+        if(!workerOf(universe).socket->joinUniverse(universe))
             return false;
 
-        {
-            std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex); 
-            m_universes.emplace(universe, new sACNUniverseInput());
-        }
+        std::unique_ptr<sACNUniverseInput> input = std::make_unique<sACNUniverseInput>(synchronization, mergeMode, universe);
+        input->setMetrics(&m_metrics->universe(universe));
+        return m_universes.insert(universe, std::move(input));
+    }
 
-        {
-            std::lock_guard<std::shared_timed_mutex> writeLockID(m_IDmutex); 
-            m_universeIDs.insert(universe);
-        }
+    /**
+     * @brief Registers a callback that is called whenever the merged DMX data of a universe changes, with the 
+     * channels changed and the receive time. See sACNUniverseInput::subscribe().
+     * 
+     * @throw std::out_of_range exception if the universe was not first added with addUniverse()
+     * @param universe the universe to watch
+     * @param callback the function to call, from a receiving thread
+     * @return size_t an id to pass to unsubscribe()
+     */
+    size_t subscribe(const uint16_t& universe, std::function<void(const DMXChangeEvent&)> callback)
+    {
+        return at(universe)->subscribe(std::move(callback));
+    }
 
-        return true;
+    /**
+     * @brief Removes a callback registered with subscribe()
+     * 
+     * @throw std::out_of_range exception if the universe was not first added with addUniverse()
+     * @param universe the universe the callback was registered for
+     * @param subscription the id returned by subscribe()
+     * @return true: the callback was removed
+     * @return false: there was no callback with this id
+     */
+    bool unsubscribe(const uint16_t& universe, size_t subscription)
+    {
+        return at(universe)->unsubscribe(subscription);
+    }
+
+    /**
+     * @brief Sets the queue every accepted DMX packet of a universe is pushed to. See sACNUniverseInput::setFrameQueue().
+     * 
+     * @throw std::out_of_range exception if the universe was not first added with addUniverse()
+     * @param universe the universe to queue the frames of
+     * @param queue the queue, or nullptr to stop queueing frames
+     */
+    void setFrameQueue(const uint16_t& universe, std::shared_ptr<sACNFrameQueue> queue)
+    {
+        at(universe)->setFrameQueue(std::move(queue));
+    }
+
+    /**
+     * @brief Sets one queue for the frames of all universes added so far. As the queue has a single producer, 
+     * this requires a single receive worker.
+     * 
+     * @throw std::invalid_argument exception if there is more than one receive worker
+     * @param queue the queue, or nullptr to stop queueing frames
+     */
+    void setFrameQueue(std::shared_ptr<sACNFrameQueue> queue)
+    {
+        if(m_workers.size() > 1)
+            throw std::invalid_argument("A frame queue for all universes requires a single receive worker.");
+
+        m_universes.forEach([&queue](uint16_t, sACNUniverseInput& input) {
+            input.setFrameQueue(queue);
+        });
     }
 
     /**
@@ -115,8 +367,7 @@ public:
      */
     bool hasUniverse(const uint16_t& universe)
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_IDmutex);
-        return m_universeIDs.count(universe) != 0;
+        return m_universes.contains(universe);
     }
 
     /**
@@ -140,68 +391,392 @@ public:
      */
     sACNUniverseInput* at(const uint16_t& universe)
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);                
         return m_universes.at(universe);
     }
 
 private:
 
     /**
-     * @brief Executes the receiver thread, until m_running is set to false.
+     * @brief A socket with its thread and receive buffers
+     * 
+     */
+    struct ReceiveWorker
+    {
+        /**
+         * @brief the number of the worker
+         * 
+         */
+        size_t index;
+
+        /**
+         * @brief The socket used for receiving sACN
+         * 
+         */
+        std::unique_ptr<sACNReceiverSocket> socket;
+
+        /**
+         * @brief the thread polling the socket, or running the io_context in asynchronous mode
+         * 
+         */
+        std::thread thread;
+
+        /**
+         * @brief the packets used to receive a batch, owned by m_packetPool. 
+         * 
+         */
+        std::vector<sACNPacketPool::Pointer> receivePackets;
+
+        /**
+         * @brief pointers to the receivePackets, as passed to the socket. 
+         * The data will be copied from here.
+         * 
+         */
+        std::vector<sACNPacket*> receiveBuffers;
+
+        /**
+         * @brief the number of bytes received into each of the receiveBuffers
+         * 
+         */
+        std::vector<size_t> receiveLengths;
+
+        /**
+         * @brief the number of batches handled
+         * 
+         */
+        std::atomic<uint64_t> batches{0};
+
+        /**
+         * @brief the number of packets handled
+         * 
+         */
+        std::atomic<uint64_t> packets{0};
+
+        /**
+         * @brief the time spent handling packets, in nanoseconds
+         * 
+         */
+        std::atomic<int64_t> busy{0};
+
+        /**
+         * @brief A mutex protecting pendingJoins
+         * 
+         */
+        std::mutex joinMutex;
+
+        /**
+         * @brief the universes whose multicast groups the polling thread of the worker has to join on its socket
+         * 
+         */
+        std::vector<uint16_t> pendingJoins;
+
+        /**
+         * @brief true if pendingJoins is not empty, checked by the polling thread without locking
+         * 
+         */
+        std::atomic<bool> joinsPending{false};
+    };
+
+    /**
+     * @brief Adds the metrics that are read when a snapshot is taken: the sequence statistics and 
+     * sources of the universes, and the timing of the workers.
+     * 
+     */
+    void collectMetrics(sACNMetricsSnapshot& snapshot)
+    {
+        m_universes.forEach([&snapshot](uint16_t universe, sACNUniverseInput& input) {
+            sACNUniverseStatistics statistics = input.statistics();
+            sACNUniverseMetricsSnapshot& metrics = snapshot.universe(universe);
+            metrics.packetsLost += statistics.lost;
+            metrics.packetsDropped += statistics.outOfOrder + statistics.duplicates;
+            metrics.receivedChanges += input.dmx().generation();
+            metrics.sources += input.sourceCount();
+        });
+
+        for(const std::unique_ptr<ReceiveWorker>& worker : m_workers)
+        {
+            sACNReceiveLoopMetrics loop;
+            loop.batches = worker->batches.load(std::memory_order_relaxed);
+            loop.packets = worker->packets.load(std::memory_order_relaxed);
+            loop.busy = std::chrono::nanoseconds(worker->busy.load(std::memory_order_relaxed));
+            snapshot.receiveLoops.push_back(loop);
+        }
+    }
+
+    /**
+     * @brief Creates and opens the sockets of all workers
+     * 
+     */
+    bool openSockets(const std::string& networkInterface)
+    {
+        bool shared = m_workers.size() > 1;
+        for(std::unique_ptr<ReceiveWorker>& worker : m_workers)
+        {
+            worker->socket = std::make_unique<sACNReceiverSocket>(m_iocontext, networkInterface, shared);
+            if(!worker->socket->start())
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns the worker joining the multicast group of a universe
+     * 
+     */
+    ReceiveWorker& workerOf(uint16_t universe)
+    {
+        return *m_workers[universe % m_workers.size()];
+    }
+
+    /**
+     * @brief Pins a worker thread to a core, if enabled
+     * 
+     */
+    void pinThread(std::thread& thread, size_t index)
+    {
+        if(!m_pinWorkers)
+            return;
+
+#ifdef __linux__
+        unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % cores, &cpus);
+        if(pthread_setaffinity_np(thread.native_handle(), sizeof cpus, &cpus) != 0)
+            SACNCPP_LOG(LogLevel::Warning, "Could not pin receive worker " + std::to_string(index));
+#else
+        SACNCPP_LOG(LogLevel::Warning, "Pinning receive workers is not supported on this platform.");
+#endif
+    }
+
+    /**
+     * @brief Runs the io_context from a worker thread, in asynchronous mode, until stop() is called or the
+     * io_context is stopped. A shared io_context may have work of its own that would keep run() from returning,
+     * so it is run in slices.
+     * 
+     */
+    void runIOContext()
+    {
+        while(m_contextThreadsRunning.load() && !m_iocontext->stopped())
+            m_iocontext->run_for(std::chrono::milliseconds(100));
+    }
+
+    /**
+     * @brief Executes the receiver thread of a worker, until m_running is set to false.
      * 
      */
-    void run()
+    void run(ReceiveWorker& worker)
     {
         while(m_running.load())
         {
-            while(m_socket->packetAvailable())
-            {
-                if(!m_socket->receivePacket(m_tempPacket))
-                    continue;
+            if(worker.joinsPending.load(std::memory_order_acquire))
+                joinPending(worker);
+
+            size_t received = worker.socket->receivePackets(worker.receiveBuffers.data(), worker.receiveLengths.data(), m_receiveBatchSize);
+
+            if(received > 0)
+                handlePackets(worker, received);
+
+            // a full batch means there are probably more packets waiting
+            if(received < m_receiveBatchSize)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
 
-                if(!m_tempPacket.valid())
+    /**
+     * @brief Hands the packets of the receive batch of a worker to their universes.
+     * 
+     * @param worker the worker that received the packets
+     * @param count number of packets in the receiveBuffers of the worker to handle
+     */
+    void handlePackets(ReceiveWorker& worker, size_t count)
+    {
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        sACNCaptureWriter* capture = m_capture.get();
+
+        for(size_t i = 0; i < count; i++)
+        {
+            const sACNPacket& packet = *worker.receiveBuffers[i];
+            // validated against the datagram length, the buffer behind it holds bytes of earlier packets
+            sACNPacketView view(packet, worker.receiveLengths[i]);
+
+            if(packet.isSyncPacket())
+            {
+                if(view.validSync())
                 {
-                    Logger::Log(LogLevel::Warning, "Received invalid packet!");
-                    continue;
+                    if(capture != nullptr)
+                        capture->write(packet, now);
+                    m_metrics->syncPacketReceived();
+                    handleSyncPacket(view.syncAddress(), now);
                 }
-                int universe = m_tempPacket.universe();
+                else
                 {
-                    std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-
-                    auto it = m_universes.find(universe);
-                    
-                    if(it == m_universes.end())
-                        continue;
-                    
-                    else
-                    {
-                        m_universes.at(universe)->handleNewPacket(m_tempPacket); 
-                    }    
-                }    
-                Logger::Log(LogLevel::Debug, "Universe " + std::to_string(universe) + " received new packet.");             
+                    m_metrics->invalidPacket();
+                }
+                continue;
+            }
 
+            if(!view.valid())
+            {
+                sACNUniverseMetrics* metrics = m_metrics->find(packet.universe());
+                if(metrics != nullptr)
+                    metrics->invalidPackets.fetch_add(1, std::memory_order_relaxed);
+                else
+                    m_metrics->invalidPacket();
+                SACNCPP_LOG(LogLevel::Warning, "Received invalid packet!");
+                continue;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+            if(capture != nullptr)
+                capture->write(packet, now);
+
+            uint16_t universe = view.universe();
+            sACNUniverseInput* input = m_universes.find(universe);
+
+            if(input == nullptr)
+                continue;
+
+            uint16_t syncAddress = view.syncAddress();
+            SyncGroup* group = syncAddress != 0 ? syncGroup(syncAddress) : nullptr;
+
+            if(group != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(group->mutex);
+                if(group->synchronized(now))
+                {
+                    if(input->stagePacket(packet, now))
+                        group->staged.push_back(input);
+                    continue;
+                }
+            }
+
+            input->handleNewPacket(packet, now);
+
+            SACNCPP_LOG(LogLevel::Debug, "Universe " + std::to_string(universe) + " received new packet.");
         }
+
+        // the batches of a worker are handled one after another, so its counters have a single writer
+        sACNUniverseMetrics::add(worker.batches, 1);
+        sACNUniverseMetrics::add(worker.packets, count);
+        worker.busy.store(worker.busy.load(std::memory_order_relaxed) + std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - now).count(), std::memory_order_relaxed);
     }
 
     /**
-     * @brief the universes to send to
+     * @brief The universes waiting for the synchronization packets of a synchronization address
      * 
      */
-    std::set<uint16_t> m_universeIDs;
+    struct SyncGroup
+    {
+        /**
+         * @brief A mutex protecting all members, the packets of a group may arrive on different workers
+         * 
+         */
+        std::mutex mutex;
+
+        /**
+         * @brief the universes with staged data, to be published with the next synchronization packet
+         * 
+         */
+        std::vector<sACNUniverseInput*> staged;
+
+        /**
+         * @brief the time the last synchronization packet was received
+         * 
+         */
+        std::chrono::steady_clock::time_point lastSync;
+
+        /**
+         * @brief true if any synchronization packet was received
+         * 
+         */
+        bool receivedSync = false;
+
+        /**
+         * @brief returns if the source is sending synchronization packets, so data has to be staged
+         * 
+         */
+        bool synchronized(std::chrono::steady_clock::time_point now) const
+        {
+            return receivedSync && now - lastSync < std::chrono::milliseconds(E131_NETWORK_DATA_LOSS_TIMEOUT);
+        }
+    };
 
     /**
-     * @brief A mutex protecting m_universeIDs
+     * @brief Returns the synchronization group of a synchronization address. 
+     * The first time a synchronization address is seen, the group is created and its multicast group joined.
      * 
      */
-    std::shared_timed_mutex m_IDmutex;
-    
+    SyncGroup* syncGroup(uint16_t syncAddress)
+    {
+        SyncGroup* group = m_syncGroups.find(syncAddress);
+        if(group != nullptr)
+            return group;
+
+        // only the worker that inserts the group joins the multicast group
+        if(m_syncGroups.insert(syncAddress, std::make_unique<SyncGroup>()) && !hasUniverse(syncAddress))
+            joinFromWorker(workerOf(syncAddress), syncAddress);
+
+        return m_syncGroups.find(syncAddress);
+    }
+
     /**
-     * @brief the thread running the run method and so, the receiving thread
+     * @brief Joins the multicast group of a universe on the socket of a worker, from the thread receiving on it. 
+     * Called from the threads of other workers, which must not use the socket themselves.
      * 
      */
-    std::thread m_thread;
+    void joinFromWorker(ReceiveWorker& worker, uint16_t universe)
+    {
+        if(m_async)
+        {
+            worker.socket->postJoinUniverse(universe);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(worker.joinMutex);
+        worker.pendingJoins.push_back(universe);
+        worker.joinsPending.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Joins the multicast groups queued by joinFromWorker(), from the polling thread of the worker
+     * 
+     */
+    void joinPending(ReceiveWorker& worker)
+    {
+        std::lock_guard<std::mutex> lock(worker.joinMutex);
+        for(uint16_t universe : worker.pendingJoins)
+            worker.socket->joinUniverse(universe);
+        worker.pendingJoins.clear();
+        worker.joinsPending.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publishes the staged data of all universes synchronized by syncAddress
+     * 
+     */
+    void handleSyncPacket(uint16_t syncAddress, std::chrono::steady_clock::time_point now)
+    {
+        SyncGroup* group = m_syncGroups.find(syncAddress);
+        if(group == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->receivedSync = true;
+        group->lastSync = now;
+
+        std::chrono::steady_clock::time_point published = std::chrono::steady_clock::now();
+        for(sACNUniverseInput* input : group->staged)
+            input->publishStaged(published);
+        group->staged.clear();
+
+        SACNCPP_LOG(LogLevel::Debug, "Synchronized universes of synchronization address " + std::to_string(syncAddress));
+    }
+
+    /**
+     * @brief the synchronization groups, by synchronization address. Only accessed by the receive workers.
+     * 
+     */
+    sACNUniverseTable<SyncGroup> m_syncGroups;
 
     /**
      * @brief An atomic boolean indicating that the thread should continue running.
@@ -210,17 +785,40 @@ private:
     std::atomic_bool m_running;
 
     /**
-     * @brief The socket used for receiving sACN
+     * @brief true if the receiver was started with startAsync()
+     * 
+     */
+    bool m_async = false;
+
+    /**
+     * @brief true if the worker threads run the io_context, in asynchronous mode
+     * 
+     */
+    bool m_runContext = false;
+
+    /**
+     * @brief the maximum number of packets received at once
+     * 
+     */
+    size_t m_receiveBatchSize;
+
+    /**
+     * @brief true if the worker threads are pinned to cores
+     * 
+     */
+    bool m_pinWorkers;
+
+    /**
+     * @brief the pool the receive buffers of all workers are taken from
      * 
      */
-    std::unique_ptr<sACNReceiverSocket> m_socket;
+    sACNPacketPool m_packetPool;
 
     /**
-     * @brief a packet used to receive packets. 
-     * The data will be copied from here.
+     * @brief the receive workers. Declared after m_packetPool, so their packets are returned before the pool is destroyed.
      * 
      */
-    sACNPacket m_tempPacket;
+    std::vector<std::unique_ptr<ReceiveWorker>> m_workers;
 
     /**
      * @brief IO context used by the asio socket
@@ -229,15 +827,45 @@ private:
     std::shared_ptr<asio::io_context> m_iocontext;
 
     /**
-     * @brief The last DMX values received
+     * @brief true if m_iocontext was created by the constructor, and may be stopped and restarted
+     * 
+     */
+    bool m_ownsContext;
+
+    /**
+     * @brief keeps the io_context from running out of work while the worker threads run it
+     * 
+     */
+    std::unique_ptr<asio::executor_work_guard<asio::io_context::executor_type>> m_workGuard;
+
+    /**
+     * @brief An atomic boolean indicating that the worker threads should keep running the io_context, in asynchronous mode
+     * 
+     */
+    std::atomic_bool m_contextThreadsRunning{false};
+
+    /**
+     * @brief the universes listened to, with the last DMX values received
+     * 
+     */
+    sACNUniverseTable<sACNUniverseInput> m_universes;
+
+    /**
+     * @brief the registry the metrics are collected in
+     * 
+     */
+    std::shared_ptr<sACNMetricsRegistry> m_metrics;
+
+    /**
+     * @brief the id of the collector added to m_metrics
      * 
      */
-    std::map<uint16_t, sACNUniverseInput*> m_universes;
+    size_t m_collector = 0;
 
     /**
-     * @brief A mutex protecting the m_universes member
+     * @brief the capture valid packets are written to, if any
      * 
      */
-    std::shared_timed_mutex m_mutex;
+    std::shared_ptr<sACNCaptureWriter> m_capture;
 };
 }
\ No newline at end of file
@@ -0,0 +1,516 @@
+#pragma once
+#include <stdint.h>
+#include <sacn_universe_table.hpp>
+#include <frame_scheduler.hpp>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sACNcpp {
+
+/**
+ * @brief The live counters of a universe, updated with relaxed atomics by the receiving and sending threads.
+ *
+ * The counters of received packets are only updated while the sACNUniverseInput of the universe is locked,
+ * the counters of sent packets only by the sending thread of the universe. As every counter has a single writer
+ * at a time, add() does a relaxed load and store instead of an atomic read-modify-write, which would cost a
+ * locked instruction per packet. Counters that may be written by several threads at once (invalidPackets) use fetch_add().
+ *
+ */
+struct sACNUniverseMetrics
+{
+    /**
+     * @brief valid data packets received
+     *
+     */
+    std::atomic<uint64_t> packetsReceived{0};
+
+    /**
+     * @brief bytes of the valid data packets received
+     *
+     */
+    std::atomic<uint64_t> bytesReceived{0};
+
+    /**
+     * @brief packets sent to the universe that failed validation
+     *
+     */
+    std::atomic<uint64_t> invalidPackets{0};
+
+    /**
+     * @brief data packets sent
+     *
+     */
+    std::atomic<uint64_t> packetsSent{0};
+
+    /**
+     * @brief bytes of the data packets sent
+     *
+     */
+    std::atomic<uint64_t> bytesSent{0};
+
+    /**
+     * @brief data packets that could not be sent
+     *
+     */
+    std::atomic<uint64_t> sendFailures{0};
+
+    /**
+     * @brief data packets prepared because the DMX data changed
+     *
+     */
+    std::atomic<uint64_t> changeSends{0};
+
+    /**
+     * @brief data packets prepared to refresh unchanged DMX data
+     *
+     */
+    std::atomic<uint64_t> keepaliveSends{0};
+
+    /**
+     * @brief counts a valid packet received. Must not be called concurrently for the same universe.
+     *
+     */
+    void received(size_t bytes)
+    {
+        add(packetsReceived, 1);
+        add(bytesReceived, bytes);
+    }
+
+    /**
+     * @brief counts a packet sent. Must not be called concurrently for the same universe.
+     *
+     */
+    void sent(size_t bytes)
+    {
+        add(packetsSent, 1);
+        add(bytesSent, bytes);
+    }
+
+    /**
+     * @brief adds to a counter that is only written by one thread at a time
+     *
+     */
+    static void add(std::atomic<uint64_t>& counter, uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief The metrics of a universe at one point in time
+ *
+ */
+struct sACNUniverseMetricsSnapshot
+{
+    uint16_t universe = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t invalidPackets = 0;
+    uint64_t packetsSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t sendFailures = 0;
+    uint64_t changeSends = 0;
+    uint64_t keepaliveSends = 0;
+
+    /**
+     * @brief number of times the received DMX data changed
+     *
+     */
+    uint64_t receivedChanges = 0;
+
+    /**
+     * @brief received packets missing in sequence number gaps
+     *
+     */
+    uint64_t packetsLost = 0;
+
+    /**
+     * @brief received packets dropped because they arrived late or duplicated
+     *
+     */
+    uint64_t packetsDropped = 0;
+
+    /**
+     * @brief the number of sources currently sending the universe
+     *
+     */
+    uint64_t sources = 0;
+};
+
+/**
+ * @brief The timing of a thread receiving packets
+ *
+ */
+struct sACNReceiveLoopMetrics
+{
+    /**
+     * @brief batches of packets handled
+     *
+     */
+    uint64_t batches = 0;
+
+    /**
+     * @brief packets handled
+     *
+     */
+    uint64_t packets = 0;
+
+    /**
+     * @brief time spent handling packets
+     *
+     */
+    std::chrono::nanoseconds busy{0};
+};
+
+/**
+ * @brief The metrics of a sACNMetricsRegistry at one point in time
+ *
+ */
+struct sACNMetricsSnapshot
+{
+    /**
+     * @brief the metrics per universe, ordered by universe
+     *
+     */
+    std::vector<sACNUniverseMetricsSnapshot> universes;
+
+    /**
+     * @brief invalid packets received, including packets of universes not listened to
+     *
+     */
+    uint64_t invalidPackets = 0;
+
+    /**
+     * @brief synchronization packets received
+     *
+     */
+    uint64_t syncPacketsReceived = 0;
+
+    /**
+     * @brief synchronization packets sent
+     *
+     */
+    uint64_t syncPacketsSent = 0;
+
+    /**
+     * @brief the timing of the receiving threads
+     *
+     */
+    std::vector<sACNReceiveLoopMetrics> receiveLoops;
+
+    /**
+     * @brief the timing of the sending threads
+     *
+     */
+    std::vector<FrameSchedulerMetrics> sendLoops;
+
+    /**
+     * @brief Returns the metrics of a universe, adding them if the universe is not in the snapshot yet
+     *
+     */
+    sACNUniverseMetricsSnapshot& universe(uint16_t universe)
+    {
+        auto it = std::lower_bound(universes.begin(), universes.end(), universe,
+            [](const sACNUniverseMetricsSnapshot& metrics, uint16_t id) { return metrics.universe < id; });
+
+        if(it == universes.end() || it->universe != universe)
+        {
+            it = universes.insert(it, sACNUniverseMetricsSnapshot());
+            it->universe = universe;
+        }
+        return *it;
+    }
+
+    /**
+     * @brief the packets lost by all universes
+     *
+     */
+    uint64_t packetsLost() const
+    {
+        uint64_t result = 0;
+        for(const sACNUniverseMetricsSnapshot& metrics : universes)
+            result += metrics.packetsLost;
+        return result;
+    }
+
+    /**
+     * @brief Formats the snapshot in the Prometheus text exposition format
+     *
+     * @return std::string
+     */
+    std::string toPrometheus() const
+    {
+        std::ostringstream out;
+
+        auto header = [&out](const char* name, const char* type, const char* help) {
+            out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+        };
+
+        auto perUniverse = [&](const char* name, const char* type, const char* help,
+            uint64_t sACNUniverseMetricsSnapshot::*member) {
+            header(name, type, help);
+            for(const sACNUniverseMetricsSnapshot& metrics : universes)
+                out << name << "{universe=\"" << metrics.universe << "\"} " << metrics.*member << "\n";
+        };
+
+        auto seconds = [](std::chrono::nanoseconds duration) {
+            return std::chrono::duration<double>(duration).count();
+        };
+
+        perUniverse("sacn_universe_packets_received_total", "counter", "Valid data packets received.", &sACNUniverseMetricsSnapshot::packetsReceived);
+        perUniverse("sacn_universe_bytes_received_total", "counter", "Bytes of the valid data packets received.", &sACNUniverseMetricsSnapshot::bytesReceived);
+        perUniverse("sacn_universe_invalid_packets_total", "counter", "Invalid packets received.", &sACNUniverseMetricsSnapshot::invalidPackets);
+        perUniverse("sacn_universe_received_changes_total", "counter", "Changes of the received DMX data.", &sACNUniverseMetricsSnapshot::receivedChanges);
+        perUniverse("sacn_universe_packets_lost_total", "counter", "Received packets missing in sequence number gaps.", &sACNUniverseMetricsSnapshot::packetsLost);
+        perUniverse("sacn_universe_packets_dropped_total", "counter", "Received packets dropped as late or duplicated.", &sACNUniverseMetricsSnapshot::packetsDropped);
+        perUniverse("sacn_universe_sources", "gauge", "Sources currently sending the universe.", &sACNUniverseMetricsSnapshot::sources);
+        perUniverse("sacn_universe_packets_sent_total", "counter", "Data packets sent.", &sACNUniverseMetricsSnapshot::packetsSent);
+        perUniverse("sacn_universe_bytes_sent_total", "counter", "Bytes of the data packets sent.", &sACNUniverseMetricsSnapshot::bytesSent);
+        perUniverse("sacn_universe_send_failures_total", "counter", "Data packets that could not be sent.", &sACNUniverseMetricsSnapshot::sendFailures);
+        perUniverse("sacn_universe_change_sends_total", "counter", "Data packets sent because the DMX data changed.", &sACNUniverseMetricsSnapshot::changeSends);
+        perUniverse("sacn_universe_keepalive_sends_total", "counter", "Data packets sent to refresh unchanged DMX data.", &sACNUniverseMetricsSnapshot::keepaliveSends);
+
+        header("sacn_invalid_packets_total", "counter", "Invalid packets received, including universes not listened to.");
+        out << "sacn_invalid_packets_total " << invalidPackets << "\n";
+        header("sacn_packets_lost_total", "counter", "Received packets missing in sequence number gaps, of all universes.");
+        out << "sacn_packets_lost_total " << packetsLost() << "\n";
+        header("sacn_sync_packets_received_total", "counter", "Synchronization packets received.");
+        out << "sacn_sync_packets_received_total " << syncPacketsReceived << "\n";
+        header("sacn_sync_packets_sent_total", "counter", "Synchronization packets sent.");
+        out << "sacn_sync_packets_sent_total " << syncPacketsSent << "\n";
+
+        header("sacn_receive_batches_total", "counter", "Batches of packets handled per receiving thread.");
+        for(size_t i = 0; i < receiveLoops.size(); i++)
+            out << "sacn_receive_batches_total{worker=\"" << i << "\"} " << receiveLoops[i].batches << "\n";
+        header("sacn_receive_packets_total", "counter", "Packets handled per receiving thread.");
+        for(size_t i = 0; i < receiveLoops.size(); i++)
+            out << "sacn_receive_packets_total{worker=\"" << i << "\"} " << receiveLoops[i].packets << "\n";
+        header("sacn_receive_busy_seconds_total", "counter", "Time spent handling packets per receiving thread.");
+        for(size_t i = 0; i < receiveLoops.size(); i++)
+            out << "sacn_receive_busy_seconds_total{worker=\"" << i << "\"} " << seconds(receiveLoops[i].busy) << "\n";
+
+        header("sacn_send_frames_total", "counter", "Frames started per sending thread.");
+        for(size_t i = 0; i < sendLoops.size(); i++)
+            out << "sacn_send_frames_total{worker=\"" << i << "\"} " << sendLoops[i].ticks << "\n";
+        header("sacn_send_missed_deadlines_total", "counter", "Frame deadlines missed per sending thread.");
+        for(size_t i = 0; i < sendLoops.size(); i++)
+            out << "sacn_send_missed_deadlines_total{worker=\"" << i << "\"} " << sendLoops[i].missedDeadlines << "\n";
+        header("sacn_send_loop_seconds", "gauge", "Work duration of the last frame per sending thread.");
+        for(size_t i = 0; i < sendLoops.size(); i++)
+            out << "sacn_send_loop_seconds{worker=\"" << i << "\"} " << seconds(sendLoops[i].lastWorkDuration) << "\n";
+        header("sacn_send_loop_max_seconds", "gauge", "Longest work duration of a frame per sending thread.");
+        for(size_t i = 0; i < sendLoops.size(); i++)
+            out << "sacn_send_loop_max_seconds{worker=\"" << i << "\"} " << seconds(sendLoops[i].maxWorkDuration) << "\n";
+        header("sacn_send_jitter_max_seconds", "gauge", "Longest wake up delay after a frame deadline per sending thread.");
+        for(size_t i = 0; i < sendLoops.size(); i++)
+            out << "sacn_send_jitter_max_seconds{worker=\"" << i << "\"} " << seconds(sendLoops[i].maxJitter) << "\n";
+
+        return out.str();
+    }
+};
+
+/**
+ * @brief Collects the metrics of sACNInputs and sACNOutputs.
+ *
+ * Counters updated on the hot path are kept per universe in sACNUniverseMetrics, looked up without locks.
+ * Metrics that are cheaper to read when a snapshot is taken (timing, sequence statistics) are added by
+ * collectors registered by the inputs and outputs using this registry.
+ * A registry may be shared by several inputs and outputs.
+ *
+ */
+class sACNMetricsRegistry
+{
+public:
+
+    typedef std::function<void(sACNMetricsSnapshot&)> Collector;
+
+    /**
+     * @brief Returns the counters of a universe, adding them if needed
+     *
+     * @param universe the id of the universe
+     * @return sACNUniverseMetrics& the counters, valid as long as the registry exists
+     */
+    sACNUniverseMetrics& universe(uint16_t universe)
+    {
+        sACNUniverseMetrics* metrics = m_universes.find(universe);
+        if(metrics != nullptr)
+            return *metrics;
+
+        m_universes.insert(universe, std::make_unique<sACNUniverseMetrics>());
+        return *m_universes.find(universe);
+    }
+
+    /**
+     * @brief Returns the counters of a universe, or nullptr if the universe was not added
+     *
+     */
+    sACNUniverseMetrics* find(uint16_t universe) const
+    {
+        return m_universes.find(universe);
+    }
+
+    /**
+     * @brief counts an invalid packet, of a universe not in the registry
+     *
+     */
+    void invalidPacket()
+    {
+        m_invalidPackets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief counts a synchronization packet received
+     *
+     */
+    void syncPacketReceived()
+    {
+        m_syncPacketsReceived.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief counts a synchronization packet sent
+     *
+     */
+    void syncPacketSent()
+    {
+        m_syncPacketsSent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registers a function adding metrics to every snapshot
+     *
+     * @param collector the function, called by snapshot()
+     * @return size_t an id to pass to removeCollector()
+     */
+    size_t addCollector(Collector collector)
+    {
+        std::lock_guard<std::mutex> lock(m_collectorMutex);
+        m_collectors.emplace_back(m_nextCollector, std::move(collector));
+        return m_nextCollector++;
+    }
+
+    /**
+     * @brief Removes a function registered with addCollector()
+     *
+     * @param collector the id returned by addCollector()
+     */
+    void removeCollector(size_t collector)
+    {
+        std::lock_guard<std::mutex> lock(m_collectorMutex);
+        m_collectors.erase(std::remove_if(m_collectors.begin(), m_collectors.end(),
+            [collector](const std::pair<size_t, Collector>& entry) { return entry.first == collector; }), m_collectors.end());
+    }
+
+    /**
+     * @brief Returns the current value of all metrics
+     *
+     * @return sACNMetricsSnapshot
+     */
+    sACNMetricsSnapshot snapshot()
+    {
+        sACNMetricsSnapshot result;
+        result.universes.reserve(m_universes.size());
+
+        m_universes.forEach([&result](uint16_t universe, const sACNUniverseMetrics& metrics) {
+            sACNUniverseMetricsSnapshot& snapshot = result.universe(universe);
+            snapshot.packetsReceived = metrics.packetsReceived.load(std::memory_order_relaxed);
+            snapshot.bytesReceived = metrics.bytesReceived.load(std::memory_order_relaxed);
+            snapshot.invalidPackets = metrics.invalidPackets.load(std::memory_order_relaxed);
+            snapshot.packetsSent = metrics.packetsSent.load(std::memory_order_relaxed);
+            snapshot.bytesSent = metrics.bytesSent.load(std::memory_order_relaxed);
+            snapshot.sendFailures = metrics.sendFailures.load(std::memory_order_relaxed);
+            snapshot.changeSends = metrics.changeSends.load(std::memory_order_relaxed);
+            snapshot.keepaliveSends = metrics.keepaliveSends.load(std::memory_order_relaxed);
+            result.invalidPackets += snapshot.invalidPackets;
+        });
+
+        result.invalidPackets += m_invalidPackets.load(std::memory_order_relaxed);
+        result.syncPacketsReceived = m_syncPacketsReceived.load(std::memory_order_relaxed);
+        result.syncPacketsSent = m_syncPacketsSent.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(m_collectorMutex);
+        for(const std::pair<size_t, Collector>& collector : m_collectors)
+            collector.second(result);
+
+        return result;
+    }
+
+    /**
+     * @brief Writes a snapshot in the Prometheus text exposition format to a file, e.g. for the textfile collector
+     * of the node exporter. The file is replaced atomically, so a scraper never reads a partial file.
+     *
+     * @param path the file to write
+     * @return true: the file was written
+     * @return false: the file could not be written
+     */
+    bool writePrometheus(const std::string& path)
+    {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::trunc);
+            if(!file)
+                return false;
+
+            file << snapshot().toPrometheus();
+            if(!file.flush())
+                return false;
+        }
+
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+
+private:
+
+    /**
+     * @brief the counters per universe
+     *
+     */
+    sACNUniverseTable<sACNUniverseMetrics> m_universes;
+
+    /**
+     * @brief invalid packets of universes not in the registry
+     *
+     */
+    std::atomic<uint64_t> m_invalidPackets{0};
+
+    /**
+     * @brief synchronization packets received
+     *
+     */
+    std::atomic<uint64_t> m_syncPacketsReceived{0};
+
+    /**
+     * @brief synchronization packets sent
+     *
+     */
+    std::atomic<uint64_t> m_syncPacketsSent{0};
+
+    /**
+     * @brief the functions registered with addCollector(), with their ids
+     *
+     */
+    std::vector<std::pair<size_t, Collector>> m_collectors;
+
+    /**
+     * @brief the id of the next collector
+     *
+     */
+    size_t m_nextCollector = 0;
+
+    /**
+     * @brief A mutex protecting m_collectors
+     *
+     */
+    std::mutex m_collectorMutex;
+};
+
+}
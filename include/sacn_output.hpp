@@ -3,11 +3,19 @@
 #include <asio_standalone_or_boost.hpp>
 #include <sacn_sender_socket.hpp>
 #include <sacn_universe_output.hpp>
+#include <frame_scheduler.hpp>
+#include <sacn_metrics.hpp>
+#include <sacn_universe_table.hpp>
 #include <atomic>
 #include <thread>
 #include <memory>
 #include <chrono>
 #include <array>
+#include <vector>
+#include <shared_mutex>
+#include <mutex>
+#include <algorithm>
+#include <stdexcept>
 
 namespace sACNcpp {
 
@@ -17,6 +25,16 @@ namespace sACNcpp {
  * A separate thread is used in the background.
  * sACN is only sent (using the values in the DMXUniverseData accessible by dmx()) when start() was called. 
  * 
+ * The universes can be partitioned across several send workers, each with its own thread, socket and frame 
+ * schedule. The schedules of the workers are offset by a fraction of the frame period, so their sends are 
+ * spread over the frame. New universes are assigned to the worker with the fewest universes, synchronized 
+ * universes are moved to the worker of their synchronization address (syncAddress % workers), so that its 
+ * synchronization packet follows all of their data. A universe is only ever sent by one worker at a time, 
+ * so its packets stay in order.
+ * 
+ * Packets, bytes, send failures and change-driven versus keepalive sends are counted per universe in a 
+ * sACNMetricsRegistry, which also collects the frame timing of the workers when a snapshot is taken.
+ * 
  */
 class sACNOutput {
 
@@ -26,18 +44,31 @@ public:
      * 
      * @param io_context the asio iocontext object to use for the underlying socket, optional
      * @param unchangedRefreshRate the refresh rate to send packets when no changes are made to the DMXUniverseData class
+     * @param frameRate the rate at which all universes are checked for changes and sent, in frames per second
+     * @param sendWorkers the number of threads and sockets the universes are partitioned across, at least 1
      */
     sACNOutput( 
         std::shared_ptr<asio::io_context> io_context = nullptr, 
-        uint16_t unchangedRefreshRate=5) :
+        uint16_t unchangedRefreshRate=5,
+        double frameRate=200,
+        size_t sendWorkers=1) :
         m_iocontext(io_context),
         m_unchangedRefreshRate(unchangedRefreshRate)
     {       
+        for(size_t i = 0; i < std::max<size_t>(sendWorkers, 1); i++)
+        {
+            m_workers.push_back(std::make_unique<SendWorker>(frameRate));
+            m_workers.back()->index = i;
+        }
+
         if(!m_iocontext)
             m_iocontext = std::make_shared<asio::io_context>();
 
-        m_tempPacket.setSourceName("sACN-cpp");
+        m_cid = generateCID();
         m_running.store(false);
+
+        m_metrics = std::make_shared<sACNMetricsRegistry>();
+        m_collector = m_metrics->addCollector([this](sACNMetricsSnapshot& snapshot) { this->collectMetrics(snapshot); });
     }
 
     /**
@@ -47,6 +78,7 @@ public:
     ~sACNOutput()
     {
         stop();
+        m_metrics->removeCollector(m_collector);
     }
 
     /**
@@ -57,27 +89,209 @@ public:
     void setSourceName(const std::string& sourceName)
     {
         std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
-        m_tempPacket.setSourceName(sourceName);
+
+        if(sourceName.size() >= 63)
+            throw std::invalid_argument("Source name too long! Maximum 63 chars.");
+
+        m_sourceName = sourceName;
+
+        m_universes.forEach([this](uint16_t, sACNUniverseOutput& output) { output.setSourceName(m_sourceName); });
     }
 
     /**
-     * @brief Starts execution of the sender. This will spawn an additional thread to send sACN in the background.
+     * @brief Set the Component Identifier (UUID) this sACN sender should appear as. 
+     * A random CID is generated when the sACNOutput is constructed.
+     * 
+     * @param cid the CID of this sender
+     */
+    void setCID(const sACNCID& cid)
+    {
+        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
+
+        m_cid = cid;
+
+        m_universes.forEach([this](uint16_t, sACNUniverseOutput& output) { output.setCID(m_cid); });
+        m_syncGroups.forEach([](uint16_t, SyncGroup& group) { group.cidChanged = true; });
+    }
+
+    /**
+     * @brief Returns the Component Identifier (UUID) this sACN sender appears as.
+     * 
+     * @return sACNCID 
+     */
+    sACNCID cid()
+    {
+        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
+        return m_cid;
+    }
+
+    /**
+     * @brief Set the priority of the data sent by this sender.
+     * 
+     * @param priority the priority, between 0 and 200. The default is 100.
+     */
+    void setPriority(uint8_t priority)
+    {
+        if(priority > 200)
+            throw std::invalid_argument("Invalid priority, only priorities between 0 and 200 are allowed.");
+
+        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
+
+        m_priority = priority;
+
+        m_universes.forEach([this](uint16_t, sACNUniverseOutput& output) { output.setPriority(m_priority); });
+    }
+
+    /**
+     * @brief Synchronizes a universe: its packets tell receivers to hold the data back until a synchronization 
+     * packet for syncAddress arrives. In every frame, the data of all universes with the same synchronization 
+     * address is sent first, followed by a single synchronization packet, so receivers apply it at once.
+     * 
+     * @param universe the universe to synchronize, has to be added with addUniverse() first
+     * @param syncAddress the universe synchronization packets are sent to, between 1 and 63999. 0 disables synchronization.
+     * @throw std::out_of_range exception if the universe was not added
+     * @throw std::invalid_argument exception if the syncAddress is out of range
+     */
+    void setSyncAddress(const uint16_t& universe, uint16_t syncAddress)
+    {
+        if(syncAddress > 63999)
+            throw std::invalid_argument("Invalid synchronization address, only universes between 1 and 63999 are allowed.");
+
+        sACNUniverseOutput* output = m_universes.at(universe);
+
+        std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex);
+
+        if(syncAddress != 0 && !m_syncGroups.contains(syncAddress))
+        {
+            std::unique_ptr<SyncGroup> group = std::make_unique<SyncGroup>(syncAddress);
+            group->packet.setCID(m_cid);
+            m_syncGroups.insert(syncAddress, std::move(group));
+        }
+
+        output->setSyncAddress(syncAddress);
+
+        // assignUniverse() waits for the packet the universe's worker may still be sending, so its packets stay in order
+        if(syncAddress != 0)
+            assignUniverse(output, *m_workers[syncAddress % m_workers.size()]);
+    }
+
+    /**
+     * @brief Returns the registry the metrics of this output are collected in
+     * 
+     * @return std::shared_ptr<sACNMetricsRegistry> 
+     */
+    std::shared_ptr<sACNMetricsRegistry> metrics() const
+    {
+        return m_metrics;
+    }
+
+    /**
+     * @brief Sets the registry the metrics of this output are collected in, e.g. to share one registry with a sACNInput. 
+     * The counters of the universes start at zero in the new registry.
+     * 
+     * @throw std::invalid_argument exception if registry is empty
+     * @throw std::logic_error exception if the output is running
+     * @param registry the registry to use
+     */
+    void setMetricsRegistry(std::shared_ptr<sACNMetricsRegistry> registry)
+    {
+        if(!registry)
+            throw std::invalid_argument("The metrics registry must not be empty.");
+        if(m_running.load())
+            throw std::logic_error("The metrics registry can only be changed while the output is stopped.");
+
+        m_metrics->removeCollector(m_collector);
+        m_metrics = std::move(registry);
+        m_universes.forEach([this](uint16_t universe, sACNUniverseOutput& output) { 
+            output.setMetrics(&m_metrics->universe(universe)); 
+        });
+        m_collector = m_metrics->addCollector([this](sACNMetricsSnapshot& snapshot) { this->collectMetrics(snapshot); });
+    }
+
+    /**
+     * @brief Set the rate at which all universes are checked for changes and sent. 
+     * E.g. 44 matches the maximum DMX refresh rate.
+     * 
+     * @param frameRate frames per second, has to be greater than 0
+     */
+    void setFrameRate(double frameRate)
+    {
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+            worker->scheduler.setFrameRate(frameRate);
+    }
+
+    /**
+     * @brief Returns the timing metrics of a sending thread: work duration per frame, 
+     * wake up jitter and missed frame deadlines.
+     * 
+     * @param worker the send worker, smaller than sendWorkers()
+     * @return FrameSchedulerMetrics 
+     */
+    FrameSchedulerMetrics frameMetrics(size_t worker = 0) const
+    {
+        return m_workers.at(worker)->scheduler.metrics();
+    }
+
+    /**
+     * @brief the number of send workers
+     * 
+     * @return size_t 
+     */
+    size_t sendWorkers() const
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * @brief Returns the number of universes assigned to a send worker
+     * 
+     * @param worker the send worker, smaller than sendWorkers()
+     * @return size_t 
+     */
+    size_t workerUniverses(size_t worker)
+    {
+        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
+        return m_workers.at(worker)->universes.size();
+    }
+
+    /**
+     * @brief Returns the number of packets (including synchronization packets) sent since start
+     * 
+     * @return uint64_t 
+     */
+    uint64_t packetsSent() const
+    {
+        uint64_t result = 0;
+        for(const std::unique_ptr<SendWorker>& worker : m_workers)
+            result += worker->packetsSent.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    /**
+     * @brief Starts execution of the sender. This will spawn an additional thread per send worker to send sACN in the background.
      * @param networkInterface The network interface to use. If none is provided, some interface/the default will be chosen. 
-     * @return true: creation of the socket was successful
-     * @return false: there was an error constructing the socket
+     * @return true: creation of the sockets was successful
+     * @return false: there was an error constructing the sockets
      */
     bool start(std::string networkInterface="")
     {
         if(m_running.load())
             return false;
 
-        m_socket = std::make_unique<sACNSenderSocket>(m_iocontext, networkInterface);
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+        {
+            worker->socket = std::make_unique<sACNSenderSocket>(m_iocontext, networkInterface);
 
-        if(!m_socket->start())
-            return false;
+            if(!worker->socket->start())
+                return false;
+        }
         
         m_running.store(true);
-        m_thread = std::thread([this]() {this->run(); });
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+        {
+            SendWorker* sendWorker = worker.get();
+            worker->thread = std::thread([this, sendWorker]() { this->run(*sendWorker); });
+        }
 
         return true;
     }
@@ -92,32 +306,43 @@ public:
             return;
 
         m_running.store(false);
-        m_thread.join();
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+            worker->thread.join();
     }
 
     /**
      * @brief Adds a universe to send data to.
      * 
      * @param universe the id of the universe to start sending data to
+     * @param synchronization how concurrent access to the DMXUniverseData of the universe is synchronized
      * @return true: if the universe sender was successfully added
-     * @return false: the universe sender was already constructed
+     * @return false: the universe sender was already constructed, or the universe is not between 1 and 63999
      */
-    bool addUniverse(const uint16_t& universe)
+    bool addUniverse(const uint16_t& universe, DMXSynchronization synchronization=DMXSynchronization::Mutex)
     {        
+        if(universe < 1 || universe > 63999)
+            return false;
+
         if(hasUniverse(universe))
             return false;
 
         {
             std::lock_guard<std::shared_timed_mutex> writeLock(m_mutex); 
-            m_universes.emplace(universe, new sACNUniverseOutput(universe, m_unchangedRefreshRate));
-        }
 
-        {
-            std::lock_guard<std::shared_timed_mutex> writeLock(m_IDmutex);
-            m_universeIDs.insert(universe);
+            std::unique_ptr<sACNUniverseOutput> output = std::make_unique<sACNUniverseOutput>(universe, m_unchangedRefreshRate, synchronization);
+            output->setSourceName(m_sourceName);
+            output->setCID(m_cid);
+            output->setPriority(m_priority);
+            output->setMetrics(&m_metrics->universe(universe));
+
+            sACNUniverseOutput* added = output.get();
+            if(!m_universes.insert(universe, std::move(output)))
+                return false;
+
+            assignUniverse(added, leastLoadedWorker());
         }
 
-        Logger::Log(LogLevel::Info, "Added output for universe " + std::to_string(universe));
+        SACNCPP_LOG(LogLevel::Info, "Added output for universe " + std::to_string(universe));
 
         return true;
     }
@@ -129,8 +354,7 @@ public:
      */
     bool hasUniverse(const uint16_t& universe)
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_IDmutex);
-        return m_universeIDs.count(universe) != 0;
+        return m_universes.contains(universe);
     }
 
     /**
@@ -154,7 +378,6 @@ public:
      */
     sACNUniverseOutput* at(const uint16_t& universe)
     {
-        std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);                
         return m_universes.at(universe);
     }
 
@@ -162,83 +385,316 @@ public:
 private:
 
     /**
-     * @brief Runs the sending thread until m_running is set to false.
+     * @brief The synchronization packet of a synchronization address, and its state
+     * 
+     */
+    struct SyncGroup
+    {
+        SyncGroup(uint16_t syncAddress) : packet(sACNPacket::syncPacket(syncAddress))
+        {
+        }
+
+        /**
+         * @brief the synchronization packet sent
+         * 
+         */
+        sACNPacket packet;
+
+        /**
+         * @brief the sequence number of the next synchronization packet
+         * 
+         */
+        uint8_t sequenceNumber = 0;
+
+        /**
+         * @brief true if the CID changed since the last synchronization packet. The packet is only written 
+         * by the worker sending it, before sending, so it is not changed while being sent.
+         * 
+         */
+        bool cidChanged = false;
+
+        /**
+         * @brief true if data of a universe synchronized by this group is sent in the current frame
+         * 
+         */
+        bool pending = false;
+    };
+
+    /**
+     * @brief A thread with its socket, frame schedule and the universes it sends
+     * 
+     */
+    struct SendWorker
+    {
+        SendWorker(double frameRate) : scheduler(frameRate)
+        {
+        }
+
+        /**
+         * @brief the number of the worker
+         * 
+         */
+        size_t index = 0;
+
+        /**
+         * @brief paces the thread to the frame rate
+         * 
+         */
+        FrameScheduler scheduler;
+
+        /**
+         * @brief The thread sending the universes
+         * 
+         */
+        std::thread thread;
+
+        /**
+         * @brief The sACNSenderSocket used to send sACN
+         * 
+         */
+        std::unique_ptr<sACNSenderSocket> socket;
+
+        /**
+         * @brief the universes sent by this worker. Protected by m_mutex.
+         * 
+         */
+        std::vector<sACNUniverseOutput*> universes;
+
+        /**
+         * @brief Held while the packets of batch are prepared and sent. Moving a universe away from this worker 
+         * locks it, so a packet of the universe still being sent is not overtaken or overwritten by its new worker.
+         * 
+         */
+        std::mutex sendMutex;
+
+        /**
+         * @brief the packets of the universes that need to be sent in the current pass
+         * 
+         */
+        std::vector<const sACNPacket*> batch;
+
+        /**
+         * @brief the counters of the packets in batch, nullptr for synchronization packets
+         * 
+         */
+        std::vector<sACNUniverseMetrics*> batchMetrics;
+
+        /**
+         * @brief the synchronization groups to send a synchronization packet for in the current frame
+         * 
+         */
+        std::vector<SyncGroup*> pendingSyncGroups;
+
+        /**
+         * @brief the number of packets sent
+         * 
+         */
+        std::atomic<uint64_t> packetsSent{0};
+    };
+
+    /**
+     * @brief Runs the sending thread of a worker until m_running is set to false.
      * 
      */
-    void run()
+    void run(SendWorker& worker)
     {
+        // every worker gets its own slot in the frame
+        double frameRate = worker.scheduler.frameRate();
+        std::this_thread::sleep_for(std::chrono::duration<double>(worker.index / (frameRate * m_workers.size())));
+        worker.scheduler.start();
+
         while(m_running.load())
         {
+            FrameScheduler::Clock::time_point frameTime = worker.scheduler.waitForNextFrame();
+
+            // keeps the settings and the partition from being changed while packets are prepared. Changed headers 
+            // are written to the packets by preparePacket(), so the lock is released before sending, and the 
+            // setters do not wait for the socket.
+            std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
+            std::lock_guard<std::mutex> sending(worker.sendMutex);
+
+            worker.batch.clear();
+            worker.batchMetrics.clear();
+            for(sACNUniverseOutput* output : worker.universes)
             {
-                std::shared_lock<std::shared_timed_mutex> readLock(m_mutex);
-                std::shared_lock<std::shared_timed_mutex> readIDLock(m_IDmutex);
+                const sACNPacket* packet = output->preparePacket(frameTime);
+                if(packet != nullptr)
+                {
+                    worker.batch.push_back(packet);
+                    worker.batchMetrics.push_back(output->metrics());
+
+                    if(output->syncAddress() != 0)
+                        markSyncGroup(worker, output->syncAddress());
+                }
+            }
 
-                for(uint16_t k : m_universeIDs)
+            // the synchronization packets follow the data of their universes in the same batch
+            for(SyncGroup* group : worker.pendingSyncGroups)
+            {
+                if(group->cidChanged)
                 {
-                    if(m_universes.at(k)->getNewPacketData(m_tempPacket))
-                    {
-                        m_socket->sendPacketMulticast(m_tempPacket);
-                    }
+                    group->packet.setCID(m_cid);
+                    group->cidChanged = false;
                 }
+                group->packet.setSequenceNumber(group->sequenceNumber++);
+                group->pending = false;
+                worker.batch.push_back(&group->packet);
+                worker.batchMetrics.push_back(nullptr);
+            }
+            worker.pendingSyncGroups.clear();
+            readLock.unlock();
+
+            if(!worker.batch.empty())
+            {
+                sACNBatchSendResult result = worker.socket->sendPacketsMulticast(worker.batch);
+                worker.packetsSent.fetch_add(result.sent, std::memory_order_relaxed);
+                countSent(worker, result);
             }
-            
-            std::this_thread::sleep_for(std::chrono::milliseconds(5));
         }
     }
 
     /**
-     * @brief the universes to send to
+     * @brief Counts the packets of the batch of a worker in their metrics, after the batch was sent
+     * 
+     */
+    void countSent(SendWorker& worker, const sACNBatchSendResult& result)
+    {
+        // the failed indices are ascending
+        size_t failed = 0;
+        for(size_t i = 0; i < worker.batch.size(); i++)
+        {
+            bool sent = failed == result.failed.size() || result.failed[failed] != i;
+            if(!sent)
+                failed++;
+
+            sACNUniverseMetrics* metrics = worker.batchMetrics[i];
+            if(metrics == nullptr)
+            {
+                if(sent)
+                    m_metrics->syncPacketSent();
+            }
+            else if(sent)
+            {
+                metrics->sent(worker.batch[i]->length());
+            }
+            else
+            {
+                sACNUniverseMetrics::add(metrics->sendFailures, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Adds the frame timing of the workers to a snapshot
      * 
      */
-    std::set<uint16_t> m_universeIDs;
+    void collectMetrics(sACNMetricsSnapshot& snapshot)
+    {
+        for(const std::unique_ptr<SendWorker>& worker : m_workers)
+            snapshot.sendLoops.push_back(worker->scheduler.metrics());
+    }
 
     /**
-     * @brief A mutex protecting m_universeIDs
+     * @brief Returns the worker with the fewest universes. m_mutex has to be locked.
      * 
      */
-    std::shared_timed_mutex m_IDmutex;
+    SendWorker& leastLoadedWorker()
+    {
+        SendWorker* result = m_workers.front().get();
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+        {
+            if(worker->universes.size() < result->universes.size())
+                result = worker.get();
+        }
+        return *result;
+    }
 
     /**
-     * @brief the universes objects
+     * @brief Moves a universe to a worker, removing it from the worker it was assigned to before. m_mutex has to be locked exclusively.
      * 
      */
-    std::map<uint16_t, sACNUniverseOutput*> m_universes;
+    void assignUniverse(sACNUniverseOutput* output, SendWorker& target)
+    {
+        for(std::unique_ptr<SendWorker>& worker : m_workers)
+        {
+            auto it = std::find(worker->universes.begin(), worker->universes.end(), output);
+            if(it == worker->universes.end())
+                continue;
+
+            if(worker.get() == &target)
+                return;
+
+            worker->universes.erase(it);
+
+            // the worker may still be sending the last packet of the universe, after it released m_mutex
+            std::lock_guard<std::mutex> sending(worker->sendMutex);
+            break;
+        }
+        target.universes.push_back(output);
+    }
 
     /**
-     * @brief A mutex protecting m_universes
+     * @brief Schedules the synchronization packet of a synchronization address to be sent at the end of the current frame
      * 
      */
-    std::shared_timed_mutex m_mutex;
+    void markSyncGroup(SendWorker& worker, uint16_t syncAddress)
+    {
+        SyncGroup* group = m_syncGroups.find(syncAddress);
+        if(group == nullptr || group->pending)
+            return;
+
+        group->pending = true;
+        worker.pendingSyncGroups.push_back(group);
+    }
 
     /**
-     * @brief the time point the last packet was sent
+     * @brief the universes to send to
      * 
      */
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastPacket;
+    sACNUniverseTable<sACNUniverseOutput> m_universes;
 
     /**
-     * @brief The refresh rate to use when no changes are mad ein the DMXUniverseData object.
+     * @brief the synchronization groups, by synchronization address
      * 
      */
-    uint16_t m_unchangedRefreshRate;
+    sACNUniverseTable<SyncGroup> m_syncGroups;
 
     /**
-     * @brief The thread used to send sACN
+     * @brief the send workers
      * 
      */
-    std::thread m_thread;
+    std::vector<std::unique_ptr<SendWorker>> m_workers;
 
     /**
-     * @brief An atomic bool indicating the thread should keep running.
+     * @brief the registry the metrics are collected in
      * 
      */
-    std::atomic_bool m_running;
+    std::shared_ptr<sACNMetricsRegistry> m_metrics;
+
+    /**
+     * @brief the id of the collector added to m_metrics
+     * 
+     */
+    size_t m_collector = 0;
+
+    /**
+     * @brief A mutex protecting the sender settings (source name, CID and priority), the 
+     * packet headers derived from them and the universes assigned to the workers
+     * 
+     */
+    std::shared_timed_mutex m_mutex;
+
+    /**
+     * @brief The refresh rate to use when no changes are mad ein the DMXUniverseData object.
+     * 
+     */
+    uint16_t m_unchangedRefreshRate;
 
     /**
-     * @brief The sACNSenderSocket used to send sACN
+     * @brief An atomic bool indicating the thread should keep running.
      * 
      */
-    std::unique_ptr<sACNSenderSocket> m_socket;
+    std::atomic_bool m_running;
 
     /**
      * @brief IO context used by the asio socket
@@ -247,11 +703,22 @@ private:
     std::shared_ptr<asio::io_context> m_iocontext;
     
     /**
-     * @brief a packet used to send in every update. 
-     * The data will be copied to this packet before sending.
+     * @brief the source name set in every packet sent
+     * 
+     */
+    std::string m_sourceName = "sACN-cpp";
+
+    /**
+     * @brief the Component Identifier set in every packet sent
+     * 
+     */
+    sACNCID m_cid;
+
+    /**
+     * @brief the priority set in every packet sent
      * 
      */
-    sACNPacket m_tempPacket;    
+    uint8_t m_priority = E131_DEFAULT_PRIORITY;
 
 };
 }
\ No newline at end of file
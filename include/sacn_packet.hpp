@@ -3,6 +3,12 @@
 #include <stdbool.h>
 #include <sys/types.h>
 #include <string>
+#include <cstring>
+#include <stdexcept>
+#include <array>
+#include <random>
+#include <algorithm>
+#include <asio_standalone_or_boost.hpp>
 #include <dmx_universe_data.hpp>
 
 #ifdef __GNUC__
@@ -18,18 +24,52 @@ namespace sACNcpp {
 /* E1.31 Public Constants */
 const uint16_t E131_DEFAULT_PORT = 5568;
 const uint8_t E131_DEFAULT_PRIORITY = 100;
+const uint16_t E131_NETWORK_DATA_LOSS_TIMEOUT = 2500; /* milliseconds */
+const uint8_t E131_OPTION_STREAM_TERMINATED = 0x40;
+const uint8_t E131_START_CODE_DMX = 0x00;
+const uint8_t E131_START_CODE_PER_ADDRESS_PRIORITY = 0xDD;
 
 /* E1.31 Private Constants */
 const uint16_t _E131_PREAMBLE_SIZE = 0x0010;
 const uint16_t _E131_POSTAMBLE_SIZE = 0x0000;
 const uint8_t _E131_ACN_PID[] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 const uint32_t _E131_ROOT_VECTOR = 0x00000004;
+const uint32_t _E131_ROOT_VECTOR_EXTENDED = 0x00000008;
 const uint32_t _E131_FRAME_VECTOR = 0x00000002;
+const uint32_t _E131_EXTENDED_SYNCHRONIZATION = 0x00000001;
+const uint16_t _E131_SYNC_PACKET_SIZE = 49;
 const uint8_t _E131_DMP_VECTOR = 0x02;
 const uint8_t _E131_DMP_TYPE = 0xa1;
 const uint16_t _E131_DMP_FIRST_ADDR = 0x0000;
 const uint16_t _E131_DMP_ADDR_INC = 0x0001;
 
+/**
+ * @brief The Component Identifier (UUID) of a sACN source
+ * 
+ */
+typedef std::array<uint8_t, 16> sACNCID;
+
+/**
+ * @brief Generates a random (version 4) UUID to identify a sACN source
+ * 
+ * @return sACNCID the generated CID
+ */
+inline sACNCID generateCID()
+{
+    std::random_device device;
+    std::mt19937 generator(device());
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    sACNCID cid;
+    for(uint8_t& byte : cid)
+        byte = distribution(generator);
+
+    // set the version (4) and variant (RFC 4122) bits
+    cid[6] = (cid[6] & 0x0f) | 0x40;
+    cid[8] = (cid[8] & 0x3f) | 0x80;
+    return cid;
+}
+
 /**
  * @brief A struct describing the E1.31 packet type
  * All packet contents are in network byte order/big endian
@@ -51,7 +91,7 @@ PACK(struct {
     uint32_t vector;           /* Layer Vector */
     uint8_t  source_name[64];  /* User Assigned Name of Source (UTF-8) */
     uint8_t  priority;         /* Packet Priority (0-200, default 100) */
-    uint16_t reserved;         /* Reserved (should be always 0) */
+    uint16_t sync_address;     /* Universe of the sync packets this data is synchronized by (0: unsynchronized) */
     uint8_t  seq_number;       /* Sequence Number (detect duplicates or out of order packets) */
     uint8_t  options;          /* Options Flags (bit 7: preview data, bit 6: stream terminated) */
     uint16_t universe;         /* DMX Universe Number */
@@ -68,6 +108,18 @@ PACK(struct {
     }) dmp;
 });
 
+PACK(struct { /* E1.31 Synchronization Packet: 49 bytes */
+    uint8_t  root_layer[38];   /* ACN Root Layer, same layout as above, with the extended root vector */
+
+    PACK(struct { /* Synchronization Framing Layer: 11 bytes */
+    uint16_t flength;          /* Flags (high 4 bits) & Length (low 12 bits) */
+    uint32_t vector;           /* Layer Vector */
+    uint8_t  seq_number;       /* Sequence Number */
+    uint16_t sync_address;     /* Synchronization Universe */
+    uint16_t reserved;         /* Reserved (should be always 0) */
+    }) frame;
+}) sync;
+
 uint8_t raw[638]; /* raw buffer view: 638 bytes */
 } sacn_packet_struct;
 
@@ -80,49 +132,73 @@ class sACNPacket
 
     public:
         /**
-         * @brief Construct a new sACNPacket object and initalizes the packet structure
+         * @brief Construct a new sACNPacket object and initalizes the packet structure.
+         * The packet structure is stored inline, so packets can be kept in arrays and copied or moved freely.
          * 
          * @param universe the universe this packet represents
          * @param num_slots the slots to send, defaults to 512
          */
         sACNPacket(uint16_t universe = 1, uint16_t num_slots = 512)
         {
-            packedPacket = new sacn_packet_struct();
-
             // clear packet
-            memset(packedPacket, 0, sizeof *packedPacket);
+            memset(&packedPacket, 0, sizeof packedPacket);
 
             setNumDMXSlots(num_slots);
 
             // set Root Layer values
-            packedPacket->root.preamble_size = htons(_E131_PREAMBLE_SIZE);
-            packedPacket->root.postamble_size = htons(_E131_POSTAMBLE_SIZE);
-            memcpy(packedPacket->root.acn_pid, _E131_ACN_PID, sizeof packedPacket->root.acn_pid);
-            packedPacket->root.vector = htonl(_E131_ROOT_VECTOR);
-            //packedPacket->root.cid = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x67, 0x65, 0x37, 0x00, 0x00, 0x00, 0x47, 0x55};
+            packedPacket.root.preamble_size = htons(_E131_PREAMBLE_SIZE);
+            packedPacket.root.postamble_size = htons(_E131_POSTAMBLE_SIZE);
+            memcpy(packedPacket.root.acn_pid, _E131_ACN_PID, sizeof packedPacket.root.acn_pid);
+            packedPacket.root.vector = htonl(_E131_ROOT_VECTOR);
+            //packedPacket.root.cid = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x67, 0x65, 0x37, 0x00, 0x00, 0x00, 0x47, 0x55};
 
             // set Framing Layer values 
-            packedPacket->frame.vector = htonl(_E131_FRAME_VECTOR);
-            packedPacket->frame.priority = E131_DEFAULT_PRIORITY;
-            packedPacket->frame.universe = htons(universe);
+            packedPacket.frame.vector = htonl(_E131_FRAME_VECTOR);
+            packedPacket.frame.priority = E131_DEFAULT_PRIORITY;
+            packedPacket.frame.universe = htons(universe);
 
             // set Device Management Protocol (DMP) Layer values
-            packedPacket->dmp.vector = _E131_DMP_VECTOR;
-            packedPacket->dmp.type = _E131_DMP_TYPE;
-            packedPacket->dmp.first_addr = htons(_E131_DMP_FIRST_ADDR);
-            packedPacket->dmp.addr_inc = htons(_E131_DMP_ADDR_INC);
+            packedPacket.dmp.vector = _E131_DMP_VECTOR;
+            packedPacket.dmp.type = _E131_DMP_TYPE;
+            packedPacket.dmp.first_addr = htons(_E131_DMP_FIRST_ADDR);
+            packedPacket.dmp.addr_inc = htons(_E131_DMP_ADDR_INC);
 
         }
 
         /**
-         * @brief Destroy the sACNPacket object and deletes to paket structure
+         * @brief Creates a synchronization packet, telling receivers to apply the data received for all
+         * universes synchronized by syncAddress.
          * 
+         * @param syncAddress the synchronization universe, between 1 and 63999
+         * @return sACNPacket the synchronization packet
          */
-        ~sACNPacket()
+        static sACNPacket syncPacket(uint16_t syncAddress)
         {
-            delete(packedPacket);
+            sACNPacket packet;
+            sacn_packet_struct& packed = packet.packedPacket;
+            memset(&packed, 0, sizeof packed);
+
+            uint16_t frame_length = sizeof packed.sync.frame;
+            uint16_t root_length = sizeof packed.root.flength +
+                sizeof packed.root.vector + sizeof packed.root.cid + frame_length;
+
+            packed.root.preamble_size = htons(_E131_PREAMBLE_SIZE);
+            packed.root.postamble_size = htons(_E131_POSTAMBLE_SIZE);
+            memcpy(packed.root.acn_pid, _E131_ACN_PID, sizeof packed.root.acn_pid);
+            packed.root.flength = htons(0x7000 | root_length);
+            packed.root.vector = htonl(_E131_ROOT_VECTOR_EXTENDED);
+
+            packed.sync.frame.flength = htons(0x7000 | frame_length);
+            packed.sync.frame.vector = htonl(_E131_EXTENDED_SYNCHRONIZATION);
+            packet.setSyncAddress(syncAddress);
+            return packet;
         }
 
+        sACNPacket(const sACNPacket&) = default;
+        sACNPacket(sACNPacket&&) = default;
+        sACNPacket& operator=(const sACNPacket&) = default;
+        sACNPacket& operator=(sACNPacket&&) = default;
+
         /**
          * @brief the (maximum) size of the sacn packet, in bytes
          * 
@@ -134,13 +210,67 @@ class sACNPacket
         }
 
         /**
-         * @brief number of dmx slots in this packet
+         * @brief the number of bytes of this packet to send, as given by the length of the root layer
+         * 
+         * @return size_t 
+         */
+        size_t length() const
+        {
+            return _E131_PREAMBLE_SIZE + (ntohs(packedPacket.root.flength) & 0x0FFF);
+        }
+
+        /**
+         * @brief number of dmx slots in this packet, not counting the start code. At most 512.
          * 
          * @return uint16_t 
          */
         uint16_t numDMXSlots() const
         {
-            return ntohs(packedPacket->dmp.prop_val_cnt)-1;
+            uint16_t prop_val_cnt = ntohs(packedPacket.dmp.prop_val_cnt);
+            if(prop_val_cnt == 0)
+                return 0;
+            return std::min<uint16_t>(prop_val_cnt - 1, 512);
+        }
+
+        /**
+         * @brief the start code of this packet: E131_START_CODE_DMX for levels, 
+         * E131_START_CODE_PER_ADDRESS_PRIORITY for per slot priorities
+         * 
+         * @return uint8_t 
+         */
+        uint8_t startCode() const
+        {
+            return packedPacket.dmp.prop_val[0];
+        }
+
+        /**
+         * @brief Set the start code of this packet
+         * 
+         * @param startCode 
+         */
+        void setStartCode(uint8_t startCode)
+        {
+            packedPacket.dmp.prop_val[0] = startCode;
+        }
+
+        /**
+         * @brief the slot data of this packet, following the start code
+         * 
+         * @return const uint8_t* numDMXSlots() bytes
+         */
+        const uint8_t* slotData() const
+        {
+            return packedPacket.dmp.prop_val + 1;
+        }
+
+        /**
+         * @brief the slot data of this packet, following the start code
+         * 
+         * @return uint8_t* numDMXSlots() bytes
+         */
+        uint8_t* slotData()
+        {
+            return packedPacket.dmp.prop_val + 1;
         }
 
         /**
@@ -152,15 +282,15 @@ class sACNPacket
             //   // compute packet layer lengths
             uint16_t prop_val_cnt = dmx_slots + 1;
             uint16_t dmp_length = prop_val_cnt +
-                sizeof packedPacket->dmp - sizeof packedPacket->dmp.prop_val;
-            uint16_t frame_length = sizeof packedPacket->frame + dmp_length;
-            uint16_t root_length = sizeof packedPacket->root.flength +
-                sizeof packedPacket->root.vector + sizeof packedPacket->root.cid + frame_length;
+                sizeof packedPacket.dmp - sizeof packedPacket.dmp.prop_val;
+            uint16_t frame_length = sizeof packedPacket.frame + dmp_length;
+            uint16_t root_length = sizeof packedPacket.root.flength +
+                sizeof packedPacket.root.vector + sizeof packedPacket.root.cid + frame_length;
 
-            packedPacket->root.flength = htons(0x7000 | root_length);
-            packedPacket->frame.flength = htons(0x7000 | frame_length);
-            packedPacket->dmp.flength = htons(0x7000 | dmp_length);
-            packedPacket->dmp.prop_val_cnt = htons(prop_val_cnt);
+            packedPacket.root.flength = htons(0x7000 | root_length);
+            packedPacket.frame.flength = htons(0x7000 | frame_length);
+            packedPacket.dmp.flength = htons(0x7000 | dmp_length);
+            packedPacket.dmp.prop_val_cnt = htons(prop_val_cnt);
 
         }
 
@@ -171,7 +301,7 @@ class sACNPacket
          */
         sacn_packet_struct* getPackedPacket() 
         { 
-            return packedPacket; 
+            return &packedPacket; 
         }
 
         /**
@@ -181,39 +311,116 @@ class sACNPacket
          */
         const sacn_packet_struct* getPackedPacket() const
         { 
-            return packedPacket; 
+            return &packedPacket; 
         }
 
+        /**
+         * @brief the sequence number of this data or synchronization packet
+         * 
+         * @return uint8_t 
+         */
         uint8_t sequenceNumber() const
         {
-            return packedPacket->frame.seq_number;
+            if(isSyncPacket())
+                return packedPacket.sync.frame.seq_number;
+            return packedPacket.frame.seq_number;
         }
 
+        /**
+         * @brief Sets the sequence number of this data or synchronization packet
+         * 
+         * @param value 
+         */
         void setSequenceNumber(uint8_t value)
         {
-            packedPacket->frame.seq_number = value;
+            if(isSyncPacket())
+                packedPacket.sync.frame.seq_number = value;
+            else
+                packedPacket.frame.seq_number = value;
+        }
+
+        /**
+         * @brief the synchronization address. For data packets, the universe of the synchronization packets
+         * the data has to wait for (0 if the data is not synchronized). For synchronization packets, the 
+         * universe that is synchronized.
+         * 
+         * @return uint16_t 
+         */
+        uint16_t syncAddress() const
+        {
+            if(isSyncPacket())
+                return ntohs(packedPacket.sync.frame.sync_address);
+            return ntohs(packedPacket.frame.sync_address);
+        }
+
+        /**
+         * @brief Sets the synchronization address, see syncAddress()
+         * 
+         * @param syncAddress the synchronization universe, between 1 and 63999. For data packets, 0 disables synchronization.
+         */
+        void setSyncAddress(uint16_t syncAddress)
+        {
+            if(syncAddress > 63999 || (syncAddress == 0 && isSyncPacket()))
+            {
+                throw std::invalid_argument("Invalid synchronization address, only universes between 1 and 63999 are allowed.");
+            }
+
+            if(isSyncPacket())
+                packedPacket.sync.frame.sync_address = htons(syncAddress);
+            else
+                packedPacket.frame.sync_address = htons(syncAddress);
+        }
+
+        /**
+         * @brief returns if this is a synchronization packet (as opposed to a data packet). 
+         * Only the root and framing layer vectors are checked, use validSync() to check the whole packet.
+         * 
+         */
+        bool isSyncPacket() const
+        {
+            return packedPacket.root.vector == htonl(_E131_ROOT_VECTOR_EXTENDED) && 
+                packedPacket.sync.frame.vector == htonl(_E131_EXTENDED_SYNCHRONIZATION);
+        }
+
+        /**
+         * @brief the universe whose multicast group this packet is sent to: the universe for data packets,
+         * the synchronization address for synchronization packets
+         * 
+         * @return uint16_t 
+         */
+        uint16_t destinationUniverse() const
+        {
+            if(isSyncPacket())
+                return ntohs(packedPacket.sync.frame.sync_address);
+            return ntohs(packedPacket.frame.universe);
         }
 
         /**
          * @brief gets a dmx channel value stored in this packet
          * 
-         * @param channel the channel to get
+         * @param channel the channel to get, between 0 and 511 (the slot following the start code is channel 0)
+         * @throw std::out_of_range if channel is greater than 511
          * @return uint8_t the value
          */
         uint8_t dmx(uint16_t channel) const
         {
-            return packedPacket->dmp.prop_val[channel];
+            if(channel > 511)
+                throw std::out_of_range("Invalid channel, only channels between 0 and 511 are allowed.");
+            return slotData()[channel];
         }
 
         /**
          * @brief sets a dmx channel in this value to a specified value
          * 
-         * @param channel 
-         * @param value 
+         * @param channel the channel to set, between 0 and 511 (the slot following the start code is channel 0)
+         * @param value the value
+         * @throw std::out_of_range if channel is greater than 511
          */
         void setDMX(uint16_t channel, uint8_t value)
         {
-            packedPacket->dmp.prop_val[channel] = value;
+            if(channel > 511)
+                throw std::out_of_range("Invalid channel, only channels between 0 and 511 are allowed.");
+            slotData()[channel] = value;
         }
 
         /**
@@ -223,7 +430,7 @@ class sACNPacket
          */
         void getDMXDataCopy(DMXUniverseData& result) const
         {
-            result.read(packedPacket->dmp.prop_val, numDMXSlots());            
+            result.read(slotData(), numDMXSlots());            
         }
 
         /**
@@ -234,7 +441,7 @@ class sACNPacket
         void setDMXDataCopy(DMXUniverseData& data)
         {
             setNumDMXSlots(512);
-            data.write(packedPacket->dmp.prop_val, 512);
+            data.write(slotData(), 512);
         }
 
         /**
@@ -244,7 +451,7 @@ class sACNPacket
          */
         std::string sourceName() const
         {
-            return std::string((char*)packedPacket->frame.source_name);
+            return std::string((char*)packedPacket.frame.source_name);
         }
 
         /**
@@ -258,7 +465,29 @@ class sACNPacket
             {
                 throw std::invalid_argument("Source name too long! Maximum 63 chars.");
             }
-            strcpy((char*)packedPacket->frame.source_name, name.c_str());            
+            strcpy((char*)packedPacket.frame.source_name, name.c_str());            
+        }
+
+        /**
+         * @brief the Component Identifier (UUID) of the source that sent this packet
+         * 
+         * @return sACNCID 
+         */
+        sACNCID cid() const
+        {
+            sACNCID result;
+            memcpy(result.data(), packedPacket.root.cid, result.size());
+            return result;
+        }
+
+        /**
+         * @brief Sets the Component Identifier (UUID) stored in this packet
+         * 
+         * @param cid the CID of the sending source
+         */
+        void setCID(const sACNCID& cid)
+        {
+            memcpy(packedPacket.root.cid, cid.data(), cid.size());
         }
 
         /**
@@ -268,7 +497,7 @@ class sACNPacket
          */
         uint16_t universe() const
         {
-            return ntohs(packedPacket->frame.universe);
+            return ntohs(packedPacket.frame.universe);
         }
 
         /**
@@ -282,7 +511,7 @@ class sACNPacket
             {
                 throw std::invalid_argument("Invalid universe number, only universes between 1 and 63999 are allowed.");
             }
-            packedPacket->frame.universe = htons(universe);
+            packedPacket.frame.universe = htons(universe);
         }
 
         /**
@@ -292,7 +521,7 @@ class sACNPacket
          */
         uint8_t priority() const
         {
-            return packedPacket->frame.priority;
+            return packedPacket.frame.priority;
         } 
 
         /**
@@ -302,9 +531,30 @@ class sACNPacket
          */
         void setPriority(uint8_t priority)
         {
-            packedPacket->frame.priority = priority;
+            packedPacket.frame.priority = priority;
         } 
 
+        /**
+         * @brief returns if the source terminated the stream of this universe with this packet
+         * 
+         */
+        bool streamTerminated() const
+        {
+            return (packedPacket.frame.options & E131_OPTION_STREAM_TERMINATED) != 0;
+        }
+
+        /**
+         * @brief Sets or clears the stream terminated option, telling receivers this source stops sending the universe
+         * 
+         */
+        void setStreamTerminated(bool terminated)
+        {
+            if(terminated)
+                packedPacket.frame.options |= E131_OPTION_STREAM_TERMINATED;
+            else
+                packedPacket.frame.options &= ~E131_OPTION_STREAM_TERMINATED;
+        }
+
         /**
          * @brief checks this packet for validity
          * 
@@ -313,23 +563,44 @@ class sACNPacket
          */
         bool valid() const
         {
-            if (ntohs(packedPacket->root.preamble_size) != _E131_PREAMBLE_SIZE)
+            if (ntohs(packedPacket.root.preamble_size) != _E131_PREAMBLE_SIZE)
+                return false;
+            if (ntohs(packedPacket.root.postamble_size) != _E131_POSTAMBLE_SIZE)
+                return false;
+            if (memcmp(packedPacket.root.acn_pid, _E131_ACN_PID, sizeof packedPacket.root.acn_pid) != 0)
+                return false;
+            if (ntohl(packedPacket.root.vector) != _E131_ROOT_VECTOR)
+                return false;
+            if (ntohl(packedPacket.frame.vector) != _E131_FRAME_VECTOR)
+                return false;
+            if (packedPacket.dmp.vector != _E131_DMP_VECTOR)
                 return false;
-            if (ntohs(packedPacket->root.postamble_size) != _E131_POSTAMBLE_SIZE)
+            if (packedPacket.dmp.type != _E131_DMP_TYPE)
                 return false;
-            if (memcmp(packedPacket->root.acn_pid, _E131_ACN_PID, sizeof packedPacket->root.acn_pid) != 0)
+            if (htons(packedPacket.dmp.first_addr) != _E131_DMP_FIRST_ADDR)
                 return false;
-            if (ntohl(packedPacket->root.vector) != _E131_ROOT_VECTOR)
+            if (htons(packedPacket.dmp.addr_inc) != _E131_DMP_ADDR_INC)
                 return false;
-            if (ntohl(packedPacket->frame.vector) != _E131_FRAME_VECTOR)
+            return true;
+        }
+
+        /**
+         * @brief checks if this is a valid synchronization packet
+         * 
+         * @return true looks like a valid sACN synchronization packet
+         * @return false not a valid synchronization packet
+         */
+        bool validSync() const
+        {
+            if (ntohs(packedPacket.root.preamble_size) != _E131_PREAMBLE_SIZE)
                 return false;
-            if (packedPacket->dmp.vector != _E131_DMP_VECTOR)
+            if (ntohs(packedPacket.root.postamble_size) != _E131_POSTAMBLE_SIZE)
                 return false;
-            if (packedPacket->dmp.type != _E131_DMP_TYPE)
+            if (memcmp(packedPacket.root.acn_pid, _E131_ACN_PID, sizeof packedPacket.root.acn_pid) != 0)
                 return false;
-            if (htons(packedPacket->dmp.first_addr) != _E131_DMP_FIRST_ADDR)
+            if (!isSyncPacket())
                 return false;
-            if (htons(packedPacket->dmp.addr_inc) != _E131_DMP_ADDR_INC)
+            if (length() < _E131_SYNC_PACKET_SIZE)
                 return false;
             return true;
         }
@@ -340,7 +611,7 @@ class sACNPacket
          * @brief struct containing the packet data
          * 
          */
-        sacn_packet_struct* packedPacket;
+        sacn_packet_struct packedPacket;
         
 };
 
@@ -0,0 +1,132 @@
+#pragma once
+#include <sacn_packet.hpp>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+namespace sACNcpp {
+
+/**
+ * @brief A fixed capacity pool of sACNPackets stored in contiguous memory.
+ *
+ * All packets are allocated when the pool is constructed, acquiring and releasing packets
+ * afterwards never calls the allocator. Packets are returned to the pool automatically
+ * when the sACNPacketPool::Pointer acquired is destroyed.
+ * The pool has to outlive all packets acquired from it.
+ *
+ */
+class sACNPacketPool
+{
+public:
+
+    /**
+     * @brief Returns a packet to the pool it was acquired from
+     *
+     */
+    class Releaser
+    {
+    public:
+        Releaser(sACNPacketPool* pool = nullptr) : m_pool(pool)
+        {
+        }
+
+        void operator()(sACNPacket* packet) const
+        {
+            if(m_pool != nullptr)
+                m_pool->release(packet);
+        }
+
+    private:
+        sACNPacketPool* m_pool;
+    };
+
+    /**
+     * @brief An owning pointer to a packet of the pool, releasing the packet when destroyed
+     *
+     */
+    typedef std::unique_ptr<sACNPacket, Releaser> Pointer;
+
+    /**
+     * @brief Construct a new sACNPacketPool object and allocates all packets
+     *
+     * @param capacity the number of packets in the pool
+     */
+    sACNPacketPool(size_t capacity) :
+        m_packets(capacity)
+    {
+        m_free.reserve(capacity);
+        for(size_t i = capacity; i > 0; i--)
+            m_free.push_back(&m_packets[i-1]);
+    }
+
+    sACNPacketPool(const sACNPacketPool&) = delete;
+    sACNPacketPool& operator=(const sACNPacketPool&) = delete;
+
+    /**
+     * @brief Takes a packet from the pool. The packet keeps the contents it had when it was released.
+     *
+     * @return Pointer the packet, or an empty pointer if all packets are in use
+     */
+    Pointer acquire()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if(m_free.empty())
+            return Pointer();
+
+        sACNPacket* packet = m_free.back();
+        m_free.pop_back();
+        return Pointer(packet, Releaser(this));
+    }
+
+    /**
+     * @brief the number of packets in the pool
+     *
+     */
+    size_t capacity() const
+    {
+        return m_packets.size();
+    }
+
+    /**
+     * @brief the number of packets that can currently be acquired
+     *
+     */
+    size_t available()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_free.size();
+    }
+
+private:
+
+    /**
+     * @brief returns a packet to the free list. As the free list can hold all packets, this never allocates.
+     *
+     */
+    void release(sACNPacket* packet)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(packet);
+    }
+
+    /**
+     * @brief the storage of all packets
+     *
+     */
+    std::vector<sACNPacket> m_packets;
+
+    /**
+     * @brief the packets that are not in use
+     *
+     */
+    std::vector<sACNPacket*> m_free;
+
+    /**
+     * @brief A mutex protecting m_free
+     *
+     */
+    std::mutex m_mutex;
+};
+
+}
@@ -0,0 +1,305 @@
+#pragma once
+#include <stdint.h>
+#include <sacn_packet.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace sACNcpp {
+
+/**
+ * @brief A non-owning, read only view of a received datagram, validated against the number of bytes received.
+ *
+ * sACNPacket::valid() checks the vectors of a packet but trusts its length fields, which describe the buffer
+ * the packet was received into rather than the datagram: a short datagram leaves the bytes of the previous
+ * packet behind its end. The view checks the vectors, the flags and lengths of the root, framing and DMP layers
+ * and the property value count against the datagram length, once, when it is constructed. Nothing is copied,
+ * all accessors read the datagram in place, so the buffers of a receive batch can be parsed where they are.
+ *
+ * The accessors of data packets return 0 (or nothing) unless valid() is true, the accessors shared with
+ * synchronization packets unless valid() or validSync() is true.
+ *
+ */
+class sACNPacketView
+{
+public:
+
+    /**
+     * @brief Parses a datagram
+     *
+     * @param data the datagram, has to outlive the view
+     * @param length the number of bytes received
+     */
+    sACNPacketView(const uint8_t* data, size_t length) :
+        m_packet(reinterpret_cast<const sacn_packet_struct*>(data)),
+        m_length(length)
+    {
+        m_kind = parse();
+    }
+
+    /**
+     * @brief Parses a datagram received into a packet
+     *
+     * @param packet the packet the datagram was received into, has to outlive the view
+     * @param length the number of bytes received, as returned by sACNReceiverSocket::receivePackets()
+     */
+    sACNPacketView(const sACNPacket& packet, size_t length) :
+        sACNPacketView(packet.getPackedPacket()->raw, std::min(length, sizeof(packet.getPackedPacket()->raw)))
+    {
+    }
+
+    /**
+     * @brief true if the datagram is a complete, consistent E1.31 data packet
+     *
+     */
+    bool valid() const
+    {
+        return m_kind == Kind::Data;
+    }
+
+    /**
+     * @brief true if the datagram is a complete, consistent E1.31 synchronization packet
+     *
+     */
+    bool validSync() const
+    {
+        return m_kind == Kind::Sync;
+    }
+
+    /**
+     * @brief the number of bytes of the datagram
+     *
+     */
+    size_t length() const
+    {
+        return m_length;
+    }
+
+    /**
+     * @brief the Component Identifier of the source
+     *
+     */
+    sACNCID cid() const
+    {
+        sACNCID result{};
+        if(m_kind != Kind::Invalid)
+            memcpy(result.data(), m_packet->root.cid, result.size());
+        return result;
+    }
+
+    /**
+     * @brief the sequence number of a data or synchronization packet
+     *
+     */
+    uint8_t sequenceNumber() const
+    {
+        if(m_kind == Kind::Sync)
+            return m_packet->sync.frame.seq_number;
+        return m_kind == Kind::Data ? m_packet->frame.seq_number : 0;
+    }
+
+    /**
+     * @brief the synchronization address of a data packet, or the address synchronized by a synchronization packet
+     *
+     */
+    uint16_t syncAddress() const
+    {
+        if(m_kind == Kind::Sync)
+            return ntohs(m_packet->sync.frame.sync_address);
+        return m_kind == Kind::Data ? ntohs(m_packet->frame.sync_address) : 0;
+    }
+
+    /**
+     * @brief the source name of a data packet, which may fill all 64 bytes without a terminating zero
+     *
+     */
+    std::string sourceName() const
+    {
+        if(m_kind != Kind::Data)
+            return std::string();
+        const char* name = reinterpret_cast<const char*>(m_packet->frame.source_name);
+        return std::string(name, strnlen(name, sizeof(m_packet->frame.source_name)));
+    }
+
+    /**
+     * @brief the universe of a data packet
+     *
+     */
+    uint16_t universe() const
+    {
+        return m_kind == Kind::Data ? ntohs(m_packet->frame.universe) : 0;
+    }
+
+    /**
+     * @brief the priority of a data packet
+     *
+     */
+    uint8_t priority() const
+    {
+        return m_kind == Kind::Data ? m_packet->frame.priority : 0;
+    }
+
+    /**
+     * @brief the options flags of a data packet
+     *
+     */
+    uint8_t options() const
+    {
+        return m_kind == Kind::Data ? m_packet->frame.options : 0;
+    }
+
+    /**
+     * @brief true if the stream terminated option of a data packet is set
+     *
+     */
+    bool streamTerminated() const
+    {
+        return (options() & E131_OPTION_STREAM_TERMINATED) != 0;
+    }
+
+    /**
+     * @brief the start code of a data packet
+     *
+     */
+    uint8_t startCode() const
+    {
+        return m_kind == Kind::Data ? m_packet->dmp.prop_val[0] : 0;
+    }
+
+    /**
+     * @brief the number of slots of a data packet, not counting the start code. The slots are within the datagram.
+     *
+     */
+    uint16_t numDMXSlots() const
+    {
+        return m_kind == Kind::Data ? ntohs(m_packet->dmp.prop_val_cnt) - 1 : 0;
+    }
+
+    /**
+     * @brief the slots of a data packet, following the start code
+     *
+     * @return const uint8_t* numDMXSlots() bytes, nullptr if the view is no valid data packet
+     */
+    const uint8_t* slotData() const
+    {
+        return m_kind == Kind::Data ? m_packet->dmp.prop_val + 1 : nullptr;
+    }
+
+    /**
+     * @brief Copies the slots of a data packet to a DMXUniverseData. Does nothing if the view is no valid data packet.
+     *
+     */
+    void getDMXDataCopy(DMXUniverseData& result) const
+    {
+        if(m_kind == Kind::Data)
+            result.read(slotData(), numDMXSlots());
+    }
+
+private:
+
+    /**
+     * @brief what the datagram was validated as
+     *
+     */
+    enum class Kind
+    {
+        Invalid,
+        Data,
+        Sync
+    };
+
+    /**
+     * @brief the length of the root layer (after the preamble), the framing layer and the DMP layer
+     * without their PDUs, and of the header of the DMP layer before the property values
+     *
+     */
+    static const size_t rootHeaderLength = 22;
+    static const size_t frameHeaderLength = 77;
+    static const size_t syncFrameLength = 11;
+    static const size_t dmpHeaderLength = 10;
+
+    /**
+     * @brief Validates the datagram in one pass from the root layer inwards. Every layer has to have
+     * the flags 0x7 and a length covering exactly the rest of the datagram.
+     *
+     */
+    Kind parse() const
+    {
+        if(m_length < sizeof(m_packet->root))
+            return Kind::Invalid;
+        if(ntohs(m_packet->root.preamble_size) != _E131_PREAMBLE_SIZE)
+            return Kind::Invalid;
+        if(ntohs(m_packet->root.postamble_size) != _E131_POSTAMBLE_SIZE)
+            return Kind::Invalid;
+        if(memcmp(m_packet->root.acn_pid, _E131_ACN_PID, sizeof m_packet->root.acn_pid) != 0)
+            return Kind::Invalid;
+
+        size_t rootLength = m_length - _E131_PREAMBLE_SIZE;
+        if(!layerLength(m_packet->root.flength, rootLength))
+            return Kind::Invalid;
+
+        uint32_t rootVector = ntohl(m_packet->root.vector);
+        size_t frameLength = rootLength - rootHeaderLength;
+
+        if(rootVector == _E131_ROOT_VECTOR_EXTENDED)
+        {
+            if(frameLength != syncFrameLength || !layerLength(m_packet->sync.frame.flength, frameLength))
+                return Kind::Invalid;
+            if(ntohl(m_packet->sync.frame.vector) != _E131_EXTENDED_SYNCHRONIZATION)
+                return Kind::Invalid;
+            return Kind::Sync;
+        }
+
+        if(rootVector != _E131_ROOT_VECTOR)
+            return Kind::Invalid;
+        if(frameLength < frameHeaderLength + dmpHeaderLength + 1 || !layerLength(m_packet->frame.flength, frameLength))
+            return Kind::Invalid;
+        if(ntohl(m_packet->frame.vector) != _E131_FRAME_VECTOR)
+            return Kind::Invalid;
+
+        size_t dmpLength = frameLength - frameHeaderLength;
+        if(!layerLength(m_packet->dmp.flength, dmpLength))
+            return Kind::Invalid;
+        if(m_packet->dmp.vector != _E131_DMP_VECTOR || m_packet->dmp.type != _E131_DMP_TYPE)
+            return Kind::Invalid;
+        if(ntohs(m_packet->dmp.first_addr) != _E131_DMP_FIRST_ADDR || ntohs(m_packet->dmp.addr_inc) != _E131_DMP_ADDR_INC)
+            return Kind::Invalid;
+
+        // the start code and at most 512 slots, all within the datagram
+        uint16_t propertyValues = ntohs(m_packet->dmp.prop_val_cnt);
+        if(propertyValues < 1 || propertyValues > sizeof(m_packet->dmp.prop_val) || propertyValues != dmpLength - dmpHeaderLength)
+            return Kind::Invalid;
+
+        return Kind::Data;
+    }
+
+    /**
+     * @brief true if a flags and length field has the flags 0x7 and the length expected
+     *
+     */
+    static bool layerLength(uint16_t flagsAndLength, size_t expected)
+    {
+        uint16_t value = ntohs(flagsAndLength);
+        return (value & 0xF000) == 0x7000 && (value & 0x0FFF) == expected;
+    }
+
+    /**
+     * @brief the datagram
+     *
+     */
+    const sacn_packet_struct* m_packet;
+
+    /**
+     * @brief the number of bytes of the datagram
+     *
+     */
+    size_t m_length;
+
+    /**
+     * @brief what the datagram was validated as
+     *
+     */
+    Kind m_kind;
+};
+
+}
@@ -6,8 +6,20 @@
 #include <stdbool.h>
 #include <string>
 #include <sys/types.h>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <stdexcept>
 #include <logger.hpp>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace sACNcpp {
 
 /**
@@ -22,11 +34,16 @@ class sACNReceiverSocket
          * 
          * @param context the asio::io_context to use
          * @param interface the interface to bind to. if empty, the default interface will be used.
+         * @param shared if true, several sockets can be bound to the sACN port (SO_REUSEPORT), and each socket only 
+         * receives the multicast groups it joined itself (IP_MULTICAST_ALL disabled). Unicast packets are 
+         * distributed across the sockets by the kernel, hashed by flow.
          */
-        sACNReceiverSocket(std::shared_ptr<asio::io_context> context, std::string interface = "") : 
-            m_interface(interface)
+        sACNReceiverSocket(std::shared_ptr<asio::io_context> context, std::string interface = "", bool shared = false) : 
+            m_interface(interface),
+            m_shared(shared)
         {
-            socket = std::make_unique<asio::ip::udp::socket>(*context);
+            // a strand serializes the asynchronous handlers, even if the context is run by multiple threads
+            socket = std::make_unique<asio::ip::udp::socket>(asio::make_strand(*context));
         }
 
         /**
@@ -41,23 +58,26 @@ class sACNReceiverSocket
             try
             {
                 socket->open(asio::ip::udp::v4());
-                Logger::Log(LogLevel::Info, "Opened socket.");
+                SACNCPP_LOG(LogLevel::Info, "Opened socket.");
             }
             catch(const std::exception& e)
             {
-                Logger::Log(LogLevel::Critical, "Could not open socket! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Critical, "Could not open socket! " + std::string(e.what()));
                 return false;
             }
 
+            if(m_shared && !shareSocket())
+                return false;
+
             try
             {               
                 socket->bind(asio::ip::udp::endpoint(asio::ip::udp::v4(), 5568));
                 
-                Logger::Log(LogLevel::Info, "Bound socket.");
+                SACNCPP_LOG(LogLevel::Info, "Bound socket.");
             }
             catch(const std::exception& e)
             {
-                Logger::Log(LogLevel::Critical, "Could not bind socket! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Critical, "Could not bind socket! " + std::string(e.what()));
                 return false;
             }
 
@@ -76,16 +96,28 @@ class sACNReceiverSocket
                         asio::ip::make_address_v4(0xefff0000 | universe), 
                         asio::ip::make_address_v4(m_interface)));
 
-                Logger::Log(LogLevel::Info, "Joined multicast group for universe " + std::to_string(universe));
+                SACNCPP_LOG(LogLevel::Info, "Joined multicast group for universe " + std::to_string(universe));
             }
             catch(const std::exception& e)
             {                
-                Logger::Log(LogLevel::Critical, "Could not join multicast group! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Critical, "Could not join multicast group! " + std::string(e.what()));
                 return false;
             }  
             return true;        
         }
 
+        /**
+         * @brief Joins the multicast group of a universe on the strand of the socket, between the handlers 
+         * of startAsyncReceive(). Unlike joinUniverse(), may be called from any thread while the socket 
+         * receives asynchronously. Requires the io_context to be run, errors are logged.
+         * 
+         * @param universe the universe to join
+         */
+        void postJoinUniverse(uint16_t universe)
+        {
+            asio::post(socket->get_executor(), [this, universe]() { joinUniverse(universe); });
+        }
+
         /**
          * @brief Checks if a new packet can be received.
          * 
@@ -105,20 +137,217 @@ class sACNReceiverSocket
          * @return false an error occurred while receiving the packet
          */
         bool receivePacket(sACNPacket& buffer)
+        {
+            size_t length;
+            return receivePacket(buffer, length);
+        }
+
+        /**
+         * @brief Received a packet into the packet structure provided. As the bytes behind the datagram are left 
+         * from previous packets, the packet should be validated with sACNPacketView(buffer, length).
+         * 
+         * @param buffer the packet to receive data into
+         * @param length the number of bytes received
+         * @return true no error occurred, receiving of the packet complete
+         * @return false an error occurred while receiving the packet
+         */
+        bool receivePacket(sACNPacket& buffer, size_t& length)
         {
             try
             {
-                socket->receive(asio::buffer(buffer.getPackedPacket()->raw));
+                length = socket->receive(asio::buffer(buffer.getPackedPacket()->raw));
             }
             catch(const std::exception& e)
             {                
-                Logger::Log(LogLevel::Warning, "Exception while receiving packet! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Warning, "Exception while receiving packet! " + std::string(e.what()));
+                length = 0;
                 return false;
             }         
             return true;
         }
 
+        /**
+         * @brief Receives up to count packets without blocking. On linux, all packets are fetched
+         * with a single recvmmsg() call, on other platforms they are received one by one while data is available.
+         * 
+         * @param buffers array of (at least) count pointers to the packets to receive data into
+         * @param lengths array of (at least) count values, filled with the number of bytes received into each buffer
+         * @param count maximum number of packets to receive
+         * @return size_t the number of packets received, 0 if no data was available or an error occurred
+         */
+        size_t receivePackets(sACNPacket* const* buffers, size_t* lengths, size_t count)
+        {
+#ifdef __linux__
+            // the scratch buffers only grow, so steady state receiving does not allocate
+            if(m_messages.size() < count)
+            {
+                m_messages.resize(count);
+                m_iovecs.resize(count);
+            }
+
+            for(size_t i = 0; i < count; i++)
+            {
+                m_iovecs[i].iov_base = buffers[i]->getPackedPacket()->raw;
+                m_iovecs[i].iov_len = sizeof buffers[i]->getPackedPacket()->raw;
+
+                msghdr& header = m_messages[i].msg_hdr;
+                memset(&header, 0, sizeof header);
+                header.msg_iov = &m_iovecs[i];
+                header.msg_iovlen = 1;
+            }
+
+            int received;
+            do
+            {
+                received = ::recvmmsg(socket->native_handle(), m_messages.data(), count, MSG_DONTWAIT, nullptr);
+            } 
+            while(received < 0 && errno == EINTR);
+
+            if(received < 0)
+            {
+                if(errno != EAGAIN && errno != EWOULDBLOCK)
+                    SACNCPP_LOG(LogLevel::Warning, "Exception while receiving packet! " + std::string(strerror(errno)));
+                return 0;
+            }
+
+            for(int i = 0; i < received; i++)
+                lengths[i] = m_messages[i].msg_len;
+
+            return received;
+#else
+            size_t received = 0;
+            while(received < count && packetAvailable())
+            {
+                try
+                {
+                    lengths[received] = socket->receive(asio::buffer(buffers[received]->getPackedPacket()->raw));
+                }
+                catch(const std::exception& e)
+                {                
+                    SACNCPP_LOG(LogLevel::Warning, "Exception while receiving packet! " + std::string(e.what()));
+                    break;
+                }
+                received++;
+            }
+            return received;
+#endif
+        }
+
+        /**
+         * @brief Starts receiving asynchronously on the io_context of this socket. Whenever data arrives, 
+         * all available packets are received into buffers (see receivePackets()) and handler is called 
+         * with the number of packets received, from the thread running the io_context. 
+         * Only one handler is in flight at a time, so buffers are never written while handler runs.
+         * 
+         * @param buffers array of (at least) count pointers to the packets to receive data into
+         * @param lengths array of (at least) count values, filled with the number of bytes received into each buffer
+         * @param count maximum number of packets to receive per handler call
+         * @param handler the function to call with the number of packets received. If waiting for data fails,
+         * receiving ends and the future returned by stopAsyncReceive() is ready at once.
+         * @throw std::logic_error if the socket is already receiving asynchronously, i.e. stopAsyncReceive() was not called
+         */
+        void startAsyncReceive(sACNPacket* const* buffers, size_t* lengths, size_t count, std::function<void(size_t)> handler)
+        {
+            if(m_asyncFinishedFuture.valid())
+                throw std::logic_error("The socket is already receiving asynchronously.");
+
+            m_asyncBuffers = buffers;
+            m_asyncLengths = lengths;
+            m_asyncCount = count;
+            m_asyncHandler = handler;
+            m_asyncFinished = std::promise<void>();
+            m_asyncFinishedFuture = m_asyncFinished.get_future();
+            m_asyncReceiving.store(true);
+
+            waitForPackets();
+        }
+
+        /**
+         * @brief Stops receiving asynchronously. The pending wait is cancelled on the io_context.
+         * Does nothing if the socket is not receiving asynchronously.
+         * 
+         * @return std::future<void> becomes ready when the last handler has returned. 
+         * This requires the io_context to still be run. Ready at once if the socket was not receiving asynchronously.
+         */
+        std::future<void> stopAsyncReceive()
+        {
+            if(!m_asyncFinishedFuture.valid())
+            {
+                std::promise<void> notReceiving;
+                notReceiving.set_value();
+                return notReceiving.get_future();
+            }
+
+            m_asyncReceiving.store(false);
+            asio::post(socket->get_executor(), [this]() { socket->cancel(); });
+            return std::move(m_asyncFinishedFuture);
+        }
+
     private:
+
+        /**
+         * @brief Sets the options of a shared socket, see the constructor. Has to be called before binding.
+         * 
+         */
+        bool shareSocket()
+        {
+            try
+            {
+                socket->set_option(asio::socket_base::reuse_address(true));
+            }
+            catch(const std::exception& e)
+            {
+                SACNCPP_LOG(LogLevel::Critical, "Could not set socket options! " + std::string(e.what()));
+                return false;
+            }
+
+#ifdef __linux__
+            int enable = 1;
+            int disable = 0;
+            if(::setsockopt(socket->native_handle(), SOL_SOCKET, SO_REUSEPORT, &enable, sizeof enable) != 0 ||
+                ::setsockopt(socket->native_handle(), IPPROTO_IP, IP_MULTICAST_ALL, &disable, sizeof disable) != 0)
+            {
+                SACNCPP_LOG(LogLevel::Critical, "Could not set socket options! " + std::string(strerror(errno)));
+                return false;
+            }
+#endif
+            return true;
+        }
+
+        /**
+         * @brief Waits asynchronously until the socket is readable, then drains it and waits again, 
+         * until stopAsyncReceive() is called or waiting fails.
+         * 
+         */
+        void waitForPackets()
+        {
+            socket->async_wait(asio::ip::udp::socket::wait_read, [this](const auto& error)
+            {
+                if(!error && m_asyncReceiving.load())
+                {
+                    size_t received;
+                    do
+                    {
+                        received = receivePackets(m_asyncBuffers, m_asyncLengths, m_asyncCount);
+                        if(received > 0)
+                            m_asyncHandler(received);
+                    }
+                    while(received == m_asyncCount && m_asyncReceiving.load());
+                }
+                else if(error && error != asio::error::operation_aborted && error != asio::error::would_block)
+                {
+                    // waiting again would fail again at once, so the chain ends instead of spinning
+                    SACNCPP_LOG(LogLevel::Critical, "Exception while waiting for packets, stopped receiving! " + error.message());
+                    m_asyncReceiving.store(false);
+                }
+
+                if(m_asyncReceiving.load())
+                    waitForPackets();
+                else
+                    m_asyncFinished.set_value();
+            });
+        }
+
         /**
          * @brief the asio::ip::udp::socket to use
          * 
@@ -131,11 +360,73 @@ class sACNReceiverSocket
          */
         std::string m_interface;
 
+        /**
+         * @brief true if the socket shares the port with other sockets
+         * 
+         */
+        bool m_shared;
+
         /**
          * @brief the universe to receive
          * 
          */
         uint16_t m_universe;
+
+        /**
+         * @brief buffers to receive into when receiving asynchronously
+         * 
+         */
+        sACNPacket* const* m_asyncBuffers = nullptr;
+
+        /**
+         * @brief lengths of the packets received asynchronously
+         * 
+         */
+        size_t* m_asyncLengths = nullptr;
+
+        /**
+         * @brief number of m_asyncBuffers
+         * 
+         */
+        size_t m_asyncCount = 0;
+
+        /**
+         * @brief function called with the number of packets received asynchronously
+         * 
+         */
+        std::function<void(size_t)> m_asyncHandler;
+
+        /**
+         * @brief An atomic boolean indicating that asynchronous receiving should continue.
+         * 
+         */
+        std::atomic_bool m_asyncReceiving{false};
+
+        /**
+         * @brief set when the asynchronous receive chain has ended
+         * 
+         */
+        std::promise<void> m_asyncFinished;
+
+        /**
+         * @brief the future of m_asyncFinished, valid from startAsyncReceive() until it is handed out by stopAsyncReceive()
+         * 
+         */
+        std::future<void> m_asyncFinishedFuture;
+
+#ifdef __linux__
+        /**
+         * @brief message headers used for batch receiving
+         * 
+         */
+        std::vector<mmsghdr> m_messages;
+
+        /**
+         * @brief one iovec per packet of a batch, pointing to the packet buffer
+         * 
+         */
+        std::vector<iovec> m_iovecs;
+#endif
 };
 
 }
\ No newline at end of file
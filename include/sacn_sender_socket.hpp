@@ -6,10 +6,38 @@
 #include <stdbool.h>
 #include <string>
 #include <sys/types.h>
+#include <vector>
+#include <algorithm>
 #include <logger.hpp>
 
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace sACNcpp {
 
+/**
+ * @brief The result of sending a batch of packets using sACNSenderSocket::sendPacketsMulticast()
+ * 
+ */
+struct sACNBatchSendResult
+{
+    /**
+     * @brief number of packets that were sent successfully
+     * 
+     */
+    size_t sent = 0;
+
+    /**
+     * @brief indices (into the batch passed) of the packets that could not be sent
+     * 
+     */
+    std::vector<size_t> failed;
+};
+
 /**
  * @brief A wrapper around an asio::ip::udp::socket for sending sACN.
  * 
@@ -41,11 +69,11 @@ class sACNSenderSocket
             try
             {
                 socket->open(asio::ip::udp::v4());
-                Logger::Log(LogLevel::Info, "Openend socket.");
+                SACNCPP_LOG(LogLevel::Info, "Openend socket.");
             }
             catch(const std::exception& e)
             {
-                Logger::Log(LogLevel::Critical, "Could not open socket! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Critical, "Could not open socket! " + std::string(e.what()));
                 return false;
             }
             
@@ -54,11 +82,11 @@ class sACNSenderSocket
                 try
                 {
                     socket->bind(asio::ip::udp::endpoint(asio::ip::make_address(m_interface), 34567));
-                    Logger::Log(LogLevel::Info, "Bound socket to interface " + m_interface);
+                    SACNCPP_LOG(LogLevel::Info, "Bound socket to interface " + m_interface);
                 }
                 catch(const std::exception& e)
                 {
-                    Logger::Log(LogLevel::Critical, "Could not bind socket! " + std::string(e.what()));
+                    SACNCPP_LOG(LogLevel::Critical, "Could not bind socket! " + std::string(e.what()));
                     return false;
                 }                
             }
@@ -76,22 +104,100 @@ class sACNSenderSocket
          */
         bool sendPacketMulticast(const sACNPacket& packet)
         {
-            uint16_t universe = packet.universe();
+            uint16_t universe = packet.destinationUniverse();
             asio::ip::udp::endpoint endpoint(asio::ip::make_address_v4(0xefff0000 | universe), 5568);
 
             try
             {
-                socket->send_to(asio::buffer(packet.getPackedPacket()->raw), endpoint);
+                socket->send_to(asio::buffer(packet.getPackedPacket()->raw, packet.length()), endpoint);
             }
             catch(const std::exception& e)
             {                
-                Logger::Log(LogLevel::Warning, "Could not send packet! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Warning, "Could not send packet! " + std::string(e.what()));
                 return false;
             }
-            Logger::Log(LogLevel::Debug, "Sent packet! ");
+            SACNCPP_LOG(LogLevel::Debug, "Sent packet! ");
             return true;           
         }
 
+        /**
+         * @brief Sends a batch of sACN packets, each to the multicast address corresponding to the 
+         * universe set in the packet. On linux, the whole batch is handed to the kernel with as few 
+         * sendmmsg() calls as possible, on other platforms the packets are sent one by one.
+         * 
+         * @param packets the packets to send. The packets have to stay valid until this call returns.
+         * @return sACNBatchSendResult the number of packets sent and the indices of the packets that failed
+         */
+        sACNBatchSendResult sendPacketsMulticast(const std::vector<const sACNPacket*>& packets)
+        {
+            sACNBatchSendResult result;
+
+#ifdef __linux__
+            size_t count = packets.size();
+
+            // the scratch buffers only grow, so steady state sending does not allocate
+            if(m_messages.size() < count)
+            {
+                m_messages.resize(count);
+                m_iovecs.resize(count);
+                m_addresses.resize(count);
+            }
+
+            for(size_t i = 0; i < count; i++)
+            {
+                sockaddr_in& address = m_addresses[i];
+                memset(&address, 0, sizeof address);
+                address.sin_family = AF_INET;
+                address.sin_port = htons(5568);
+                address.sin_addr.s_addr = htonl(0xefff0000 | packets[i]->destinationUniverse());
+
+                m_iovecs[i].iov_base = (void*)packets[i]->getPackedPacket()->raw;
+                m_iovecs[i].iov_len = packets[i]->length();
+
+                msghdr& header = m_messages[i].msg_hdr;
+                memset(&header, 0, sizeof header);
+                header.msg_name = &address;
+                header.msg_namelen = sizeof address;
+                header.msg_iov = &m_iovecs[i];
+                header.msg_iovlen = 1;
+            }
+
+            // a local copy, std::min takes its arguments by reference and would odr-use the static member
+            const size_t maxMessages = MAX_MESSAGES_PER_CALL;
+            size_t offset = 0;
+            while(offset < count)
+            {
+                unsigned int chunk = std::min<size_t>(count - offset, maxMessages);
+                int sent = ::sendmmsg(socket->native_handle(), &m_messages[offset], chunk, 0);
+
+                if(sent < 0)
+                {
+                    if(errno == EINTR)
+                        continue;
+
+                    // sendmmsg stops at the first failing message, skip it and carry on with the rest
+                    SACNCPP_LOG(LogLevel::Warning, "Could not send packet! " + std::string(strerror(errno)));
+                    result.failed.push_back(offset);
+                    offset++;
+                    continue;
+                }
+
+                result.sent += sent;
+                offset += sent;
+            }
+#else
+            for(size_t i = 0; i < packets.size(); i++)
+            {
+                if(sendPacketMulticast(*packets[i]))
+                    result.sent++;
+                else
+                    result.failed.push_back(i);
+            }
+#endif
+            SACNCPP_LOG(LogLevel::Debug, "Sent packet batch! ");
+            return result;
+        }
+
         /**
          * @brief Sends a sACN packet to the hostname and port provided. If no port is provided, the 
          * default port for sACN (5568) is used.
@@ -107,14 +213,14 @@ class sACNSenderSocket
             asio::ip::udp::endpoint endpoint(asio::ip::make_address(hostname), port);
             try
             {
-                socket->send_to(asio::buffer(packet.getPackedPacket()->raw), endpoint);
+                socket->send_to(asio::buffer(packet.getPackedPacket()->raw, packet.length()), endpoint);
             }
             catch(const std::exception& e)
             {
-                Logger::Log(LogLevel::Warning, "Could not send packet! " + std::string(e.what()));
+                SACNCPP_LOG(LogLevel::Warning, "Could not send packet! " + std::string(e.what()));
                 return false;
             }
-            Logger::Log(LogLevel::Debug, "Sent packet! ");
+            SACNCPP_LOG(LogLevel::Debug, "Sent packet! ");
             return true;         
         }
 
@@ -130,5 +236,31 @@ class sACNSenderSocket
          * 
          */
         std::string m_interface;
+
+#ifdef __linux__
+        /**
+         * @brief the maximum number of messages the kernel accepts in a single sendmmsg call (UIO_MAXIOV)
+         * 
+         */
+        static const size_t MAX_MESSAGES_PER_CALL = 1024;
+
+        /**
+         * @brief message headers used for batch sending
+         * 
+         */
+        std::vector<mmsghdr> m_messages;
+
+        /**
+         * @brief one iovec per packet of a batch, pointing to the packet data
+         * 
+         */
+        std::vector<iovec> m_iovecs;
+
+        /**
+         * @brief the multicast destination per packet of a batch
+         * 
+         */
+        std::vector<sockaddr_in> m_addresses;
+#endif
 };
 }
\ No newline at end of file
@@ -3,18 +3,133 @@
 #include <asio_standalone_or_boost.hpp>
 #include <sacn_receiver_socket.hpp>
 #include <dmx_universe_data.hpp>
+#include <dmx_simd.hpp>
+#include <sacn_frame_queue.hpp>
+#include <sacn_metrics.hpp>
 #include <atomic>
 #include <thread>
 #include <memory>
 #include <chrono>
 #include <array>
 #include <mutex>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace sACNcpp {
 
+/**
+ * @brief How the data of several sources sending the same universe with the same (highest) priority is combined
+ * 
+ */
+enum class DMXMergeMode
+{
+    /**
+     * @brief Highest takes precedence: every channel is set to the highest value of all sources
+     * 
+     */
+    HTP,
+
+    /**
+     * @brief Latest takes precedence: the data of the source that sent the latest packet is used
+     * 
+     */
+    LTP
+};
+
+/**
+ * @brief Counters of the packets received for a universe, from all sources
+ * 
+ */
+struct sACNUniverseStatistics
+{
+    /**
+     * @brief packets accepted
+     * 
+     */
+    uint64_t accepted = 0;
+
+    /**
+     * @brief packets dropped because they arrived after a packet with a higher sequence number
+     * 
+     */
+    uint64_t outOfOrder = 0;
+
+    /**
+     * @brief packets dropped because they repeated the sequence number of the previous packet
+     * 
+     */
+    uint64_t duplicates = 0;
+
+    /**
+     * @brief number of times the sequence number skipped ahead, i.e. packets went missing
+     * 
+     */
+    uint64_t gaps = 0;
+
+    /**
+     * @brief number of packets missing in the gaps
+     * 
+     */
+    uint64_t lost = 0;
+
+    /**
+     * @brief estimated fraction of packets lost, counting out of order packets as lost
+     * 
+     * @return double between 0 and 1
+     */
+    double lossRate() const
+    {
+        uint64_t expected = accepted + lost;
+        if(expected == 0)
+            return 0;
+        return double(lost) / double(expected);
+    }
+};
+
+/**
+ * @brief Describes a change of the merged DMX data of a universe
+ * 
+ */
+struct DMXChangeEvent
+{
+    /**
+     * @brief the universe that changed
+     * 
+     */
+    uint16_t universe = 0;
+
+    /**
+     * @brief the channels whose value changed
+     * 
+     */
+    DMXChannelMask changed;
+
+    /**
+     * @brief the time the packet causing the change was received, or the synchronization packet for synchronized universes
+     * 
+     */
+    std::chrono::steady_clock::time_point received;
+};
+
 /**
  * @brief A class handle a single received DMX universe.
  * 
+ * The state of every source sending the universe is kept, identified by its CID. Sources that did not send 
+ * for E131_NETWORK_DATA_LOSS_TIMEOUT, or that terminated their stream, are dropped. Only the sources with the 
+ * highest priority are used, their data is combined according to the DMXMergeMode.
+ * 
+ * Sources may send per address priorities (start code 0xDD). While any source does, the arbitration is done 
+ * per slot: every slot is taken from the sources with the highest priority for that slot. Packets with other 
+ * alternate start codes are ignored.
+ * 
+ * Packets are checked against the sequence number of the previous packet of their source: packets that are 
+ * duplicated or arrive up to 20 sequence numbers late are dropped, as specified by E1.31.
+ * 
+ * Subscribers are notified with a DMXChangeEvent whenever the merged data changes, from the receiving thread.
+ * Additionally, every accepted DMX packet of every source can be passed to a sACNFrameQueue, in the order received.
  * 
  */
 class sACNUniverseInput {
@@ -24,21 +139,182 @@ public:
     /**
      * @brief Construct a new sACNUniverseInput object.
      * 
+     * @param synchronization how concurrent access to the DMXUniverseData is synchronized
+     * @param mergeMode how the data of sources with the same priority is combined
+     * @param universe the id of the universe, reported in the DMXChangeEvents
      */
-    sACNUniverseInput()
+    sACNUniverseInput(DMXSynchronization synchronization=DMXSynchronization::Mutex, DMXMergeMode mergeMode=DMXMergeMode::HTP, 
+        uint16_t universe=0) :
+        m_universeValues(synchronization),
+        m_mergeMode(mergeMode),
+        m_universe(universe)
     {
-        m_lastPacket = std::chrono::high_resolution_clock::now() - std::chrono::seconds(100);
+        m_lastPacket = std::chrono::steady_clock::now() - std::chrono::seconds(100);
+
+        // room for a few sources, so the usual setups never allocate while receiving
+        m_sources.reserve(4);
+        m_mergeOrder.reserve(4);
     }
   
     /**
-     * @brief Returns the name of the sACN source this class is receiving sACN from.
+     * @brief Returns the name of the sACN source this class is receiving sACN from. 
+     * With several sources, this is the source with the highest priority that sent the latest packet.
      * 
      * @return std::string 
      */
     std::string currentDMXSource()
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        return m_currentSource;
+        if(m_currentSource >= m_sources.size())
+            return "None";
+        return std::string(m_sources[m_currentSource].name.data());
+    }
+
+    /**
+     * @brief Returns the number of sources currently sending this universe
+     * 
+     * @return size_t 
+     */
+    size_t sourceCount()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_sources.size();
+    }
+
+    /**
+     * @brief Set how the data of several sources with the same priority is combined. Takes effect with the next packet.
+     * 
+     * @param mergeMode 
+     */
+    void setMergeMode(DMXMergeMode mergeMode)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_mergeMode = mergeMode;
+    }
+
+    /**
+     * @brief Returns how the data of several sources with the same priority is combined
+     * 
+     * @return DMXMergeMode 
+     */
+    DMXMergeMode mergeMode()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_mergeMode;
+    }
+
+    /**
+     * @brief Returns the counters of the packets received for this universe
+     * 
+     * @return sACNUniverseStatistics 
+     */
+    sACNUniverseStatistics statistics()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_statistics;
+    }
+
+    /**
+     * @brief Resets the counters returned by statistics() to 0
+     * 
+     */
+    void resetStatistics()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_statistics = sACNUniverseStatistics();
+    }
+
+    /**
+     * @brief Returns the priority of the winning source(s) of every slot of dmx(), 0 for slots no source drives.
+     * 
+     * @return std::array<uint8_t, 512> 
+     */
+    std::array<uint8_t, 512> slotPriorities()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if(m_perSlotPublished)
+            return m_mergedPriorities;
+
+        std::array<uint8_t, 512> result;
+        result.fill(m_publishedPriority);
+        return result;
+    }
+
+    /**
+     * @brief the id of the universe
+     * 
+     */
+    uint16_t universe() const
+    {
+        return m_universe;
+    }
+
+    /**
+     * @brief Registers a callback that is called whenever the merged DMX data changes, with the channels changed. 
+     * The callback is called from the receiving thread after dmx() was updated, it must not call subscribe() or unsubscribe().
+     * 
+     * @param callback the function to call
+     * @return size_t an id to pass to unsubscribe()
+     */
+    size_t subscribe(std::function<void(const DMXChangeEvent&)> callback)
+    {
+        std::lock_guard<std::mutex> lk(m_subscriberMutex);
+        m_subscribers.emplace_back(m_nextSubscription, std::move(callback));
+        m_subscribed.store(true, std::memory_order_release);
+        return m_nextSubscription++;
+    }
+
+    /**
+     * @brief Removes a callback registered with subscribe()
+     * 
+     * @param subscription the id returned by subscribe()
+     * @return true: the callback was removed
+     * @return false: there was no callback with this id
+     */
+    bool unsubscribe(size_t subscription)
+    {
+        std::lock_guard<std::mutex> lk(m_subscriberMutex);
+        auto it = std::find_if(m_subscribers.begin(), m_subscribers.end(), 
+            [subscription](const Subscriber& subscriber) { return subscriber.first == subscription; });
+        if(it == m_subscribers.end())
+            return false;
+
+        m_subscribers.erase(it);
+        m_subscribed.store(!m_subscribers.empty(), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Sets the queue every accepted DMX packet is pushed to, as a sACNFrame. The receiving thread 
+     * of the universe is the producer of the queue, so a queue must only be shared by universes received by the same thread.
+     * 
+     * @param queue the queue, or nullptr to stop queueing frames
+     */
+    void setFrameQueue(std::shared_ptr<sACNFrameQueue> queue)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_frameQueue = std::move(queue);
+    }
+
+    /**
+     * @brief Returns the queue set by setFrameQueue(), or nullptr
+     * 
+     */
+    std::shared_ptr<sACNFrameQueue> frameQueue()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_frameQueue;
+    }
+
+    /**
+     * @brief Sets the counters the packets handled by this universe are counted in
+     * 
+     * @param metrics the counters, or nullptr to not count packets
+     */
+    void setMetrics(sACNUniverseMetrics* metrics)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_metrics = metrics;
     }
 
     /**
@@ -52,37 +328,603 @@ public:
     }
 
     /**
-     * @brief handles a newly received DMX packet, and copies the contained DMX data.
+     * @brief handles a newly received DMX packet, and updates the DMX data with the merge of all sources.
      * 
      * @param newPacket the packet to handle
+     * @param now the time the packet was received
      */
-    void handleNewPacket(const sACNPacket& newPacket)
+    void handleNewPacket(const sACNPacket& newPacket, 
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
     {
+        DMXChangeEvent event;
+        bool changed = false;
         {
             std::lock_guard<std::mutex> lk(m_mutex);
-            m_currentSource = newPacket.sourceName();
-            m_lastPacket = std::chrono::high_resolution_clock::now();
+            if(updateSource(newPacket, now))
+            {
+                publish(now);
+                changed = takeChange(event);
+            }
         }
-        newPacket.getDMXDataCopy(m_universeValues);
+
+        if(changed)
+            notify(event);
+    }
+
+    /**
+     * @brief handles a newly received DMX packet of a synchronized universe. The DMX data is held back 
+     * until publishStaged() is called, when the synchronization packet arrives.
+     * 
+     * @param newPacket the packet to handle
+     * @param now the time the packet was received
+     * @return true: no data was staged before, the universe has to be published with the next synchronization
+     * @return false: data of an earlier packet is still staged, or the packet was ignored
+     */
+    bool stagePacket(const sACNPacket& newPacket, 
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if(!updateSource(newPacket, now, true))
+            return false;
+
+        bool wasStaged = m_stagedPending;
+        m_stagedPending = true;
+        return !wasStaged;
+    }
+
+    /**
+     * @brief updates the DMX data with the data staged by stagePacket()
+     * 
+     * @param now the time to report as lastPublished()
+     * @return true: staged data was published
+     * @return false: there was no staged data
+     */
+    bool publishStaged(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+    {
+        DMXChangeEvent event;
+        bool changed = false;
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            if(!m_stagedPending)
+                return false;
+
+            for(Source& source : m_sources)
+            {
+                if(source.hasStaged)
+                    applyStaged(source);
+            }
+            publish(now);
+            m_stagedPending = false;
+            changed = takeChange(event);
+        }
+
+        if(changed)
+            notify(event);
+        return true;
+    }
+
+    /**
+     * @brief the time received data was last copied to dmx()
+     * 
+     * @return std::chrono::steady_clock::time_point 
+     */
+    std::chrono::steady_clock::time_point lastPublished() const
+    {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(m_lastPublished.load(std::memory_order_acquire)));
     }
 
     bool receivingData()
     {
         std::lock_guard<std::mutex> lk(m_mutex);
-        return std::chrono::high_resolution_clock::now()-m_lastPacket < std::chrono::seconds(2);
+        return std::chrono::steady_clock::now()-m_lastPacket < std::chrono::seconds(2);
     }
 
 
 private:
+
+    /**
+     * @brief The state of a source sending this universe
+     * 
+     */
+    struct Source
+    {
+        /**
+         * @brief the Component Identifier of the source
+         * 
+         */
+        sACNCID cid;
+
+        /**
+         * @brief the null terminated source name
+         * 
+         */
+        std::array<char, 64> name;
+
+        /**
+         * @brief the priority of the last packet
+         * 
+         */
+        uint8_t priority;
+
+        /**
+         * @brief the time the last packet was received
+         * 
+         */
+        std::chrono::steady_clock::time_point lastPacket;
+
+        /**
+         * @brief increases with every packet received for this universe, orders sources for LTP
+         * 
+         */
+        uint64_t order;
+
+        /**
+         * @brief the sequence number of the last packet accepted
+         * 
+         */
+        uint8_t sequence;
+
+        /**
+         * @brief the number of slots in the last packet
+         * 
+         */
+        uint16_t slots;
+
+        /**
+         * @brief the DMX data of the last packet, channels behind slots are 0
+         * 
+         */
+        std::array<uint8_t, 512> data;
+
+        /**
+         * @brief true once a packet with DMX data (start code 0) was received
+         * 
+         */
+        bool hasData;
+
+        /**
+         * @brief the DMX data of the last packet staged by stagePacket(), moved to data by publishStaged(). 
+         * Channels behind stagedSlots are undefined.
+         * 
+         */
+        std::array<uint8_t, 512> staged;
+
+        /**
+         * @brief the number of slots in the staged packet
+         * 
+         */
+        uint16_t stagedSlots;
+
+        /**
+         * @brief the priority of the staged packet
+         * 
+         */
+        uint8_t stagedPriority;
+
+        /**
+         * @brief the order of the staged packet, see order
+         * 
+         */
+        uint64_t stagedOrder;
+
+        /**
+         * @brief true while a staged packet was not published
+         * 
+         */
+        bool hasStaged;
+
+        /**
+         * @brief true while the source sends per address priorities
+         * 
+         */
+        bool hasSlotPriorities;
+
+        /**
+         * @brief the time the last per address priority packet was received
+         * 
+         */
+        std::chrono::steady_clock::time_point lastPriorityPacket;
+
+        /**
+         * @brief the per address priorities of the last 0xDD packet, slots behind the packet are 0
+         * 
+         */
+        std::array<uint8_t, 512> slotPriorities;
+    };
+
+    /**
+     * @brief Stores the data of a packet in the state of its source. Creates the source if it is new, 
+     * and drops sources that terminated or timed out.
+     * 
+     * @param stage if true, the DMX data and the priority are staged for publishStaged() instead of replacing those of the source
+     * @return true: the merged data may have changed
+     * @return false: the packet was ignored
+     */
+    bool updateSource(const sACNPacket& packet, std::chrono::steady_clock::time_point now, bool stage = false)
+    {
+        if(m_metrics != nullptr)
+            m_metrics->received(packet.length());
+
+        uint8_t startCode = packet.startCode();
+        if(startCode != E131_START_CODE_DMX && startCode != E131_START_CODE_PER_ADDRESS_PRIORITY)
+        {
+            // the sequence numbers count all packets of a source, so alternate start codes are checked but not merged
+            size_t index = findSource(packet.getPackedPacket()->root.cid);
+            if(index < m_sources.size() && acceptSequence(m_sources[index], packet.sequenceNumber()))
+                m_statistics.accepted++;
+            return false;
+        }
+
+        m_lastPacket = now;
+        removeSources([now](const Source& source) { 
+            return now - source.lastPacket >= std::chrono::milliseconds(E131_NETWORK_DATA_LOSS_TIMEOUT); 
+        });
+
+        const sacn_packet_struct* packed = packet.getPackedPacket();
+        size_t index = findSource(packed->root.cid);
+
+        if(index < m_sources.size() && !acceptSequence(m_sources[index], packet.sequenceNumber()))
+            return false;
+
+        m_statistics.accepted++;
+
+        if(packet.streamTerminated())
+        {
+            if(index < m_sources.size())
+            {
+                const sACNCID cid = m_sources[index].cid;
+                removeSources([&cid](const Source& source) { return source.cid == cid; });
+            }
+            return true;
+        }
+
+        if(index == m_sources.size())
+        {
+            m_sources.emplace_back();
+            Source& created = m_sources.back();
+            memcpy(created.cid.data(), packed->root.cid, created.cid.size());
+            created.sequence = packet.sequenceNumber();
+            created.slots = 0;
+            created.data.fill(0);
+            created.hasData = false;
+            created.hasStaged = false;
+            created.hasSlotPriorities = false;
+        }
+
+        Source& source = m_sources[index];
+        memcpy(source.name.data(), packed->frame.source_name, source.name.size());
+        source.name.back() = 0;
+        if(!stage || startCode != E131_START_CODE_DMX)
+            source.priority = packet.priority();
+        source.lastPacket = now;
+        m_lastSource = index;
+
+        uint16_t slots = packet.numDMXSlots();
+
+        if(startCode == E131_START_CODE_PER_ADDRESS_PRIORITY)
+        {
+            memcpy(source.slotPriorities.data(), packet.slotData(), slots);
+            memset(source.slotPriorities.data() + slots, 0, source.slotPriorities.size() - slots);
+            source.hasSlotPriorities = true;
+            source.lastPriorityPacket = now;
+            return source.hasData;
+        }
+
+        // per address priorities time out like sources, the universe priority applies again
+        if(source.hasSlotPriorities && 
+            now - source.lastPriorityPacket >= std::chrono::milliseconds(E131_NETWORK_DATA_LOSS_TIMEOUT))
+        {
+            source.hasSlotPriorities = false;
+        }
+
+        if(stage)
+        {
+            // held back until the synchronization packet, so merges published for other sources do not show it early
+            source.stagedOrder = ++m_packetCounter;
+            memcpy(source.staged.data(), packet.slotData(), slots);
+            source.stagedSlots = slots;
+            source.stagedPriority = packet.priority();
+            source.hasStaged = true;
+        }
+        else
+        {
+            source.order = ++m_packetCounter;
+            memcpy(source.data.data(), packet.slotData(), slots);
+            if(slots < source.slots)
+                memset(source.data.data() + slots, 0, source.slots - slots);
+            source.slots = slots;
+            source.hasData = true;
+            source.hasStaged = false;
+        }
+
+        if(m_frameQueue)
+        {
+            m_frameQueue->pushInPlace([&](sACNFrame& frame) {
+                frame.universe = m_universe;
+                frame.cid = source.cid;
+                frame.priority = packet.priority();
+                frame.sequence = packet.sequenceNumber();
+                frame.slots = slots;
+                frame.received = now;
+                memcpy(frame.data.data(), packet.slotData(), slots);
+            });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Moves the staged packet of a source to its data, see updateSource()
+     * 
+     */
+    void applyStaged(Source& source)
+    {
+        memcpy(source.data.data(), source.staged.data(), source.stagedSlots);
+        if(source.stagedSlots < source.slots)
+            memset(source.data.data() + source.stagedSlots, 0, source.slots - source.stagedSlots);
+        source.slots = source.stagedSlots;
+        source.priority = source.stagedPriority;
+        source.order = source.stagedOrder;
+        source.hasData = true;
+        source.hasStaged = false;
+    }
+
+    /**
+     * @brief The E1.31 sequence number check: returns false for packets that have to be dropped, 
+     * and counts the packet in m_statistics
+     * 
+     */
+    bool acceptSequence(Source& source, uint8_t sequence)
+    {
+        int8_t difference = (int8_t)(uint8_t)(sequence - source.sequence);
+
+        if(difference <= 0 && difference > -20)
+        {
+            if(difference == 0)
+                m_statistics.duplicates++;
+            else
+                m_statistics.outOfOrder++;
+            return false;
+        }
+
+        // larger steps back are taken as a restarted source
+        if(difference > 1)
+        {
+            m_statistics.gaps++;
+            m_statistics.lost += difference - 1;
+        }
+
+        source.sequence = sequence;
+        return true;
+    }
+
+    /**
+     * @brief Returns the index of the source with the given CID, or m_sources.size() if it is unknown
+     * 
+     */
+    size_t findSource(const uint8_t* cid) const
+    {
+        // most packets are from the same source as the previous one
+        if(m_lastSource < m_sources.size() && memcmp(m_sources[m_lastSource].cid.data(), cid, 16) == 0)
+            return m_lastSource;
+
+        for(size_t i = 0; i < m_sources.size(); i++)
+        {
+            if(memcmp(m_sources[i].cid.data(), cid, 16) == 0)
+                return i;
+        }
+        return m_sources.size();
+    }
+
+    /**
+     * @brief removes all sources a predicate is true for
+     * 
+     */
+    template<typename Predicate>
+    void removeSources(Predicate predicate)
+    {
+        auto end = std::remove_if(m_sources.begin(), m_sources.end(), predicate);
+        if(end == m_sources.end())
+            return;
+
+        m_sources.erase(end, m_sources.end());
+        m_lastSource = m_sources.size();
+        m_currentSource = m_sources.size();
+    }
+
+    /**
+     * @brief Writes the merge of the sources with the highest priority to m_universeValues. 
+     * If no source is left, the last values are kept.
+     * 
+     */
+    void publish(std::chrono::steady_clock::time_point now)
+    {
+        size_t activeSources = 0;
+        size_t active = 0;
+        bool perSlot = false;
+        for(size_t i = 0; i < m_sources.size(); i++)
+        {
+            if(!m_sources[i].hasData)
+                continue;
+
+            activeSources++;
+            active = i;
+            perSlot |= m_sources[i].hasSlotPriorities;
+        }
+
+        if(activeSources == 0)
+            return;
+
+        m_perSlotPublished = perSlot;
+
+        if(perSlot)
+        {
+            publishPerSlot(now);
+        }
+        else if(activeSources == 1)
+        {
+            // single source fast path, no merging
+            m_currentSource = active;
+            m_publishedPriority = m_sources[active].priority;
+            commit(m_sources[active].data.data(), m_sources[active].slots, now);
+        }
+        else
+        {
+            uint8_t topPriority = 0;
+            for(const Source& source : m_sources)
+            {
+                if(source.hasData)
+                    topPriority = std::max(topPriority, source.priority);
+            }
+
+            size_t latest = m_sources.size();
+            size_t topSources = 0;
+            uint16_t slots = 0;
+            for(size_t i = 0; i < m_sources.size(); i++)
+            {
+                if(!m_sources[i].hasData || m_sources[i].priority != topPriority)
+                    continue;
+
+                topSources++;
+                slots = std::max(slots, m_sources[i].slots);
+                if(latest == m_sources.size() || m_sources[i].order > m_sources[latest].order)
+                    latest = i;
+            }
+
+            m_currentSource = latest;
+            m_publishedPriority = topPriority;
+
+            if(topSources == 1 || m_mergeMode == DMXMergeMode::LTP)
+            {
+                commit(m_sources[latest].data.data(), m_sources[latest].slots, now);
+            }
+            else
+            {
+                m_merged = m_sources[latest].data;
+                for(size_t i = 0; i < m_sources.size(); i++)
+                {
+                    if(i != latest && m_sources[i].hasData && m_sources[i].priority == topPriority)
+                        simd::maximum(m_merged.data(), m_sources[i].data.data(), slots);
+                }
+                commit(m_merged.data(), slots, now);
+            }
+        }
+
+        m_lastPublished.store(now.time_since_epoch().count(), std::memory_order_release);
+    }
+
+    /**
+     * @brief Writes the per slot arbitration of all sources to m_universeValues, used while any source sends per address priorities
+     * 
+     */
+    void publishPerSlot(std::chrono::steady_clock::time_point now)
+    {
+        m_mergeOrder.clear();
+        for(size_t i = 0; i < m_sources.size(); i++)
+        {
+            if(m_sources[i].hasData)
+                m_mergeOrder.push_back(i);
+        }
+
+        // with LTP, later sources overwrite earlier ones with the same priority
+        std::sort(m_mergeOrder.begin(), m_mergeOrder.end(), [this](size_t a, size_t b) { 
+            return m_sources[a].order < m_sources[b].order; 
+        });
+
+        m_merged.fill(0);
+        m_mergedPriorities.fill(0);
+        bool highestTakesPrecedence = m_mergeMode == DMXMergeMode::HTP;
+        uint16_t slots = 0;
+
+        for(size_t index : m_mergeOrder)
+        {
+            const Source& source = m_sources[index];
+            const uint8_t* priorities = source.slotPriorities.data();
+            if(!source.hasSlotPriorities)
+            {
+                m_uniformPriorities.fill(source.priority);
+                priorities = m_uniformPriorities.data();
+            }
+
+            slots = std::max(slots, source.slots);
+            simd::priorityMerge(m_merged.data(), m_mergedPriorities.data(), 
+                source.data.data(), priorities, m_merged.size(), highestTakesPrecedence);
+        }
+
+        m_currentSource = m_mergeOrder.back();
+        commit(m_merged.data(), slots, now);
+    }
+
+    /**
+     * @brief Writes the merged data to m_universeValues, and records the changed channels if there are subscribers
+     * 
+     * @param data the merged data, holding all 512 channels, 0 behind length
+     * @param length the number of channels of the merged data
+     * @param now the time to report in the DMXChangeEvent
+     */
+    void commit(const uint8_t * data, uint16_t length, std::chrono::steady_clock::time_point now)
+    {
+        // channels of a longer universe published before are cleared, e.g. after its source left
+        uint16_t written = std::max(length, m_publishedSlots);
+        m_publishedSlots = length;
+        m_universeValues.read(data, written);
+
+        if(m_subscribed.load(std::memory_order_acquire))
+        {
+            DMXChannelMask changed = simd::diff(m_published.data(), data);
+            changed.truncate(written);
+            if(changed.any())
+            {
+                // changes of staged publishes that were not taken yet are combined
+                for(size_t i = 0; i < changed.words.size(); i++)
+                    m_change.changed.words[i] |= changed.words[i];
+                m_change.received = now;
+                m_changePending = true;
+            }
+        }
+
+        std::memcpy(m_published.data(), data, written);
+    }
+
+    /**
+     * @brief Moves the change recorded by commit() to event. m_mutex has to be locked.
+     * 
+     * @return true: there was a change
+     * @return false: nothing changed, event is untouched
+     */
+    bool takeChange(DMXChangeEvent& event)
+    {
+        if(!m_changePending)
+            return false;
+
+        event = m_change;
+        event.universe = m_universe;
+        m_change.changed = DMXChannelMask();
+        m_changePending = false;
+        return true;
+    }
+
+    /**
+     * @brief Calls all subscribers with an event. Called without m_mutex locked, so subscribers may query this object.
+     * 
+     */
+    void notify(const DMXChangeEvent& event)
+    {
+        std::lock_guard<std::mutex> lk(m_subscriberMutex);
+        for(const Subscriber& subscriber : m_subscribers)
+            subscriber.second(event);
+    }
+
+    typedef std::pair<size_t, std::function<void(const DMXChangeEvent&)>> Subscriber;
     
     /**
-     * @brief The last DMX values received
+     * @brief The current DMX values, merged from all sources
      * 
      */
     DMXUniverseData m_universeValues;
 
     /**
-     * @brief A mutex protecting private data members, currently only the m_currentSource member
+     * @brief A mutex protecting private data members: the sources, the merge mode and the staging state
      * 
      */
     std::mutex m_mutex;
@@ -91,12 +933,156 @@ private:
      * @brief the time point the last packet was received
      * 
      */
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastPacket;
+    std::chrono::steady_clock::time_point m_lastPacket;
+
+    /**
+     * @brief how sources with the same priority are combined
+     * 
+     */
+    DMXMergeMode m_mergeMode;
+
+    /**
+     * @brief the sources currently sending this universe
+     * 
+     */
+    std::vector<Source> m_sources;
+
+    /**
+     * @brief counters of the packets received
+     * 
+     */
+    sACNUniverseStatistics m_statistics;
+
+    /**
+     * @brief the index of the source of the last packet, checked first when looking up a source
+     * 
+     */
+    size_t m_lastSource = 0;
+
+    /**
+     * @brief the index of the source reported by currentDMXSource()
+     * 
+     */
+    size_t m_currentSource = 0;
+
+    /**
+     * @brief number of packets received, used to order the sources
+     * 
+     */
+    uint64_t m_packetCounter = 0;
+
+    /**
+     * @brief scratch buffer for the HTP and per slot merges
+     * 
+     */
+    std::array<uint8_t, 512> m_merged;
+
+    /**
+     * @brief the winning priority of every slot after a per slot merge
+     * 
+     */
+    std::array<uint8_t, 512> m_mergedPriorities{};
+
+    /**
+     * @brief scratch buffer holding the universe priority of a source without per address priorities
+     * 
+     */
+    std::array<uint8_t, 512> m_uniformPriorities;
+
+    /**
+     * @brief scratch list of the sources of a per slot merge, in packet order
+     * 
+     */
+    std::vector<size_t> m_mergeOrder;
+
+    /**
+     * @brief true if the last publish() used the per slot merge, and m_mergedPriorities is valid
+     * 
+     */
+    bool m_perSlotPublished = false;
+
+    /**
+     * @brief the priority of the winning source(s) of the last publish() without per slot merge
+     * 
+     */
+    uint8_t m_publishedPriority = 0;
+
+    /**
+     * @brief true if data was received for a synchronized universe that was not published yet
+     * 
+     */
+    bool m_stagedPending = false;
+
+    /**
+     * @brief the time data was last copied to m_universeValues, as steady_clock ticks
+     * 
+     */
+    std::atomic<std::chrono::steady_clock::rep> m_lastPublished{0};
+
+    /**
+     * @brief the id of the universe
+     * 
+     */
+    uint16_t m_universe;
+
+    /**
+     * @brief the counters of this universe, or nullptr
+     * 
+     */
+    sACNUniverseMetrics* m_metrics = nullptr;
+
+    /**
+     * @brief the queue accepted frames are pushed to, or nullptr
+     * 
+     */
+    std::shared_ptr<sACNFrameQueue> m_frameQueue;
+
+    /**
+     * @brief a copy of the data last written to m_universeValues, to find the channels changed
+     * 
+     */
+    std::array<uint8_t, 512> m_published{};
+
+    /**
+     * @brief the number of channels of the data last written to m_universeValues
+     * 
+     */
+    uint16_t m_publishedSlots = 0;
+
+    /**
+     * @brief the change recorded by commit() that was not notified yet
+     * 
+     */
+    DMXChangeEvent m_change;
+
+    /**
+     * @brief true if m_change holds a change
+     * 
+     */
+    bool m_changePending = false;
+
+    /**
+     * @brief true if there is at least one subscriber, so changes are recorded
+     * 
+     */
+    std::atomic<bool> m_subscribed{false};
+
+    /**
+     * @brief the callbacks registered with subscribe(), with their ids
+     * 
+     */
+    std::vector<Subscriber> m_subscribers;
+
+    /**
+     * @brief the id of the next subscription
+     * 
+     */
+    size_t m_nextSubscription = 0;
 
     /**
-     * @brief The source name of the sACN source of the last packet received.
+     * @brief A mutex protecting m_subscribers, held while subscribers are called
      * 
      */
-    std::string m_currentSource = "None";
+    std::mutex m_subscriberMutex;
 };
 }
\ No newline at end of file
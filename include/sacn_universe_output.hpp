@@ -3,11 +3,13 @@
 #include <asio_standalone_or_boost.hpp>
 #include <sacn_sender_socket.hpp>
 #include <dmx_universe_data.hpp>
+#include <sacn_metrics.hpp>
 #include <atomic>
 #include <thread>
 #include <memory>
 #include <chrono>
 #include <array>
+#include <string>
 
 namespace sACNcpp {
 
@@ -26,14 +28,78 @@ public:
      * 
      * @param universe sACN universe to output data to
      * @param unchangedRefreshRate the refresh rate to send packets when no changes are made to the DMXUniverseData class
+     * @param synchronization how concurrent access to the DMXUniverseData is synchronized
+     * @throw std::invalid_argument if universe is not between 1 and 63999
      */
     sACNUniverseOutput(uint16_t universe, 
-        uint16_t unchangedRefreshRate=5) 
+        uint16_t unchangedRefreshRate=5,
+        DMXSynchronization synchronization=DMXSynchronization::Mutex) 
         :
         m_universe(universe),
-        m_unchangedRefreshRate(unchangedRefreshRate)
+        m_unchangedRefreshRate(unchangedRefreshRate),
+        m_universeValues(synchronization),
+        m_packet(universe)
     {       
+        m_packet.setUniverse(universe);
+    }
 
+    /**
+     * @brief Sets the source name of this universe, written to its packet by the next preparePacket(). 
+     * So it may be called while the last packet is being sent, but not concurrently with preparePacket(), 
+     * sACNOutput::setSourceName() takes care of that.
+     * 
+     * @param sourceName the source name, at most 63 chars
+     */
+    void setSourceName(const std::string& sourceName)
+    {
+        m_sourceName = sourceName;
+        m_changedHeaders |= SourceNameChanged;
+    }
+
+    /**
+     * @brief Sets the CID of this universe, written to its packet by the next preparePacket(). 
+     * Must not be called concurrently with preparePacket(), sACNOutput::setCID() takes care of that.
+     * 
+     * @param cid the Component Identifier of the source
+     */
+    void setCID(const sACNCID& cid)
+    {
+        m_cid = cid;
+        m_changedHeaders |= CIDChanged;
+    }
+
+    /**
+     * @brief Sets the priority of this universe, written to its packet by the next preparePacket(). 
+     * Must not be called concurrently with preparePacket(), sACNOutput::setPriority() takes care of that.
+     * 
+     * @param priority the priority, 0-200
+     */
+    void setPriority(uint8_t priority)
+    {
+        m_priority = priority;
+        m_changedHeaders |= PriorityChanged;
+    }
+
+    /**
+     * @brief Sets the synchronization address of this universe, written to its packet by the next preparePacket(). 
+     * Must not be called concurrently with preparePacket(), sACNOutput::setSyncAddress() takes care of that.
+     * 
+     * @param syncAddress the universe synchronization packets are sent to, 0 to send unsynchronized
+     */
+    void setSyncAddress(uint16_t syncAddress)
+    {
+        m_syncAddress = syncAddress;
+        m_changedHeaders |= SyncAddressChanged;
+    }
+
+    /**
+     * @brief the synchronization address of this universe, 0 if it is not synchronized
+     * 
+     * @return uint16_t 
+     */
+    uint16_t syncAddress() const
+    {
+        return m_syncAddress;
     }
 
 
@@ -50,46 +116,161 @@ public:
         return m_universeValues;
     }
 
+    /**
+     * @brief Sets the counters that packets prepared because of changes or as keepalive are counted in
+     * 
+     * @param metrics the counters, or nullptr to not count packets
+     */
+    void setMetrics(sACNUniverseMetrics* metrics)
+    {
+        m_metrics = metrics;
+    }
+
+    /**
+     * @brief Returns the counters set by setMetrics(), or nullptr
+     * 
+     */
+    sACNUniverseMetrics* metrics() const
+    {
+        return m_metrics;
+    }
+
+    /**
+     * @brief Brings the packet of this universe up to date, if sending a packet is necessary. 
+     * Only the sequence number, the channels changed since the last packet and the headers changed 
+     * by the setters are written, all other headers are prepared when the universe is constructed.
+     * 
+     * @param now the time the packet will be sent at, used to schedule keepalive packets
+     * @return const sACNPacket*: the packet to send, valid until the next call. nullptr, if no packet needs to be sent.
+     */
+    const sACNPacket* preparePacket(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+    {
+        // read before copying, so changes made during the copy are sent again in the next frame
+        uint64_t generation = m_universeValues.generation();
+
+        if(generation == m_lastSentGeneration && 
+            now-m_lastPacket < std::chrono::milliseconds(1000/m_unchangedRefreshRate))
+        {
+            return nullptr;
+        }
+
+        if(generation != m_lastSentGeneration)
+        {
+            uint16_t first, last;
+            m_universeValues.writeDirty(m_packet.slotData(), first, last);
+            if(m_metrics != nullptr)
+                sACNUniverseMetrics::add(m_metrics->changeSends, 1);
+        }
+        else if(m_metrics != nullptr)
+        {
+            sACNUniverseMetrics::add(m_metrics->keepaliveSends, 1);
+        }
+
+        if(m_changedHeaders != 0)
+            applyHeaders();
+
+        m_packet.setSequenceNumber(m_sequenceNumber);
+        m_sequenceNumber++;
+
+        m_lastSentGeneration = generation;
+        m_lastPacket = now;
+
+        return &m_packet;
+    }
+
     /**
      * @brief fills the passed sACNPacket with new data to send, if sending a packet is necessary.
+     * This copies the packet prepared by preparePacket().
      * 
      * @param dataPacket packet reference to modify and fill with new data if new data should be sent
+     * @param now the time the packet will be sent at, used to schedule keepalive packets
      * @return true: if a new packet should be sent and the contents of dataPacket were modified
      * @return false: if now new data needs to be sent
      */
-    bool getNewPacketData(sACNPacket& dataPacket)
+    bool getNewPacketData(sACNPacket& dataPacket, 
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
     {
-        if(m_universeValues != m_lastSentValues || 
-            std::chrono::high_resolution_clock::now()-m_lastPacket > std::chrono::milliseconds(1000/m_unchangedRefreshRate))
-        {
-            dataPacket.setDMXDataCopy(m_universeValues);
-            dataPacket.setUniverse(m_universe);
-            dataPacket.setSequenceNumber(m_sequenceNumber);
+        const sACNPacket* packet = preparePacket(now);
+        if(packet == nullptr)
+            return false;
 
-            m_sequenceNumber++;
-
-            m_lastSentValues = m_universeValues;
-            m_lastPacket = std::chrono::high_resolution_clock::now();
-
-            return true;
-        }
-        return false;
+        dataPacket = *packet;
+        return true;
     }
 
 
 private:
 
+    /**
+     * @brief the headers set since the last preparePacket(), bits of m_changedHeaders
+     * 
+     */
+    enum ChangedHeader : uint8_t
+    {
+        SourceNameChanged = 1,
+        CIDChanged = 2,
+        PriorityChanged = 4,
+        SyncAddressChanged = 8
+    };
+
+    /**
+     * @brief Writes the headers set since the last preparePacket() to m_packet
+     * 
+     */
+    void applyHeaders()
+    {
+        if(m_changedHeaders & SourceNameChanged)
+            m_packet.setSourceName(m_sourceName);
+        if(m_changedHeaders & CIDChanged)
+            m_packet.setCID(m_cid);
+        if(m_changedHeaders & PriorityChanged)
+            m_packet.setPriority(m_priority);
+        if(m_changedHeaders & SyncAddressChanged)
+            m_packet.setSyncAddress(m_syncAddress);
+        m_changedHeaders = 0;
+    }
+
     /**
      * @brief the universe to send to
      * 
      */
     uint16_t m_universe;
 
+    /**
+     * @brief the synchronization address of this universe, written to m_packet by the next preparePacket()
+     * 
+     */
+    uint16_t m_syncAddress = 0;
+
+    /**
+     * @brief the source name, written to m_packet by the next preparePacket() if it changed
+     * 
+     */
+    std::string m_sourceName;
+
+    /**
+     * @brief the CID, written to m_packet by the next preparePacket() if it changed
+     * 
+     */
+    sACNCID m_cid{};
+
+    /**
+     * @brief the priority, written to m_packet by the next preparePacket() if it changed
+     * 
+     */
+    uint8_t m_priority = 0;
+
+    /**
+     * @brief the ChangedHeader bits of the headers not written to m_packet yet
+     * 
+     */
+    uint8_t m_changedHeaders = 0;
+
     /**
      * @brief the time point the last packet was sent
      * 
      */
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_lastPacket;
+    std::chrono::steady_clock::time_point m_lastPacket;
 
     /**
      * @brief The refresh rate to use when no changes are mad ein the DMXUniverseData object.
@@ -97,6 +278,10 @@ private:
      */
     uint16_t m_unchangedRefreshRate;
 
+    /**
+     * @brief The sequence number of the next packet
+     * 
+     */
     uint8_t m_sequenceNumber = 0;
 
     /**
@@ -106,10 +291,22 @@ private:
     DMXUniverseData m_universeValues;
 
     /**
-     * @brief The last dmx values of the last packet sent to network
+     * @brief The generation of m_universeValues sent in the last packet
+     * 
+     */
+    uint64_t m_lastSentGeneration = 0;
+
+    /**
+     * @brief The packet sent for this universe, with all headers prepared
+     * 
+     */
+    sACNPacket m_packet;
+
+    /**
+     * @brief the counters of this universe, or nullptr
      * 
      */
-    DMXUniverseData m_lastSentValues;
+    sACNUniverseMetrics* m_metrics = nullptr;
 
 };
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+#pragma once
+#include <stdint.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace sACNcpp {
+
+/**
+ * @brief A table of objects indexed by universe id, with constant time lock-free lookups.
+ *
+ * The 65536 possible ids are mapped by a two-level page table: the high byte selects one of
+ * 256 pages, which is only allocated when a universe in its range is inserted, the low byte
+ * selects the entry in the page. All inserted universes are additionally kept in a dense list
+ * in insertion order, so iterating costs the number of universes and not the size of the id space.
+ *
+ * Lookups and iteration never lock and may run concurrently with insert(), inserts are serialized
+ * by an internal mutex. Entries are never removed, the table owns the inserted objects until it is destroyed.
+ *
+ * @tparam T the type of the objects stored
+ */
+template<typename T>
+class sACNUniverseTable
+{
+public:
+
+    sACNUniverseTable() = default;
+    sACNUniverseTable(const sACNUniverseTable&) = delete;
+    sACNUniverseTable& operator=(const sACNUniverseTable&) = delete;
+
+    /**
+     * @brief Destroy the sACNUniverseTable object and all objects inserted
+     *
+     */
+    ~sACNUniverseTable()
+    {
+        size_t count = m_size.load(std::memory_order_acquire);
+        for(size_t i = 0; i < count; i++)
+            delete denseEntry(i).value;
+    }
+
+    /**
+     * @brief Returns the object of a universe, or nullptr if the universe was not inserted
+     *
+     * @param universe the id of the universe
+     * @return T* the object of the universe
+     */
+    T* find(uint16_t universe) const
+    {
+        IndexPage* page = m_index[universe >> 8].load(std::memory_order_acquire);
+        if(page == nullptr)
+            return nullptr;
+
+        return (*page)[universe & 0xFF].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Returns the object of a universe.
+     *
+     * @throw std::out_of_range exception if the universe was not inserted
+     * @param universe the id of the universe
+     * @return T* the object of the universe
+     */
+    T* at(uint16_t universe) const
+    {
+        T* value = find(universe);
+        if(value == nullptr)
+            throw std::out_of_range("Universe " + std::to_string(universe) + " is not in the table.");
+        return value;
+    }
+
+    /**
+     * @brief Returns if a universe was inserted
+     *
+     */
+    bool contains(uint16_t universe) const
+    {
+        return find(universe) != nullptr;
+    }
+
+    /**
+     * @brief Inserts the object of a universe, and takes ownership of it.
+     *
+     * @param universe the id of the universe
+     * @param value the object to store, must not be empty
+     * @return true: the object was inserted
+     * @return false: the universe was already in the table, value is destroyed
+     */
+    bool insert(uint16_t universe, std::unique_ptr<T> value)
+    {
+        std::lock_guard<std::mutex> lock(m_insertMutex);
+
+        if(contains(universe))
+            return false;
+
+        std::atomic<IndexPage*>& indexSlot = m_index[universe >> 8];
+        IndexPage* indexPage = indexSlot.load(std::memory_order_relaxed);
+        if(indexPage == nullptr)
+        {
+            m_indexPages[universe >> 8].reset(new IndexPage());
+            indexPage = m_indexPages[universe >> 8].get();
+            for(std::atomic<T*>& entry : *indexPage)
+                entry.store(nullptr, std::memory_order_relaxed);
+            indexSlot.store(indexPage, std::memory_order_release);
+        }
+
+        size_t position = m_size.load(std::memory_order_relaxed);
+        std::atomic<DensePage*>& denseSlot = m_dense[position >> 8];
+        DensePage* densePage = denseSlot.load(std::memory_order_relaxed);
+        if(densePage == nullptr)
+        {
+            m_densePages[position >> 8].reset(new DensePage());
+            densePage = m_densePages[position >> 8].get();
+            denseSlot.store(densePage, std::memory_order_release);
+        }
+
+        T* pointer = value.release();
+        (*densePage)[position & 0xFF] = DenseEntry{universe, pointer};
+        (*indexPage)[universe & 0xFF].store(pointer, std::memory_order_release);
+
+        // publishes the dense entry to forEach()
+        m_size.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief the number of universes inserted
+     *
+     */
+    size_t size() const
+    {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Calls f(universe, object) for every universe in the table, in insertion order.
+     * Universes inserted while iterating may or may not be visited.
+     *
+     * @param f a callable taking (uint16_t, T&)
+     */
+    template<typename F>
+    void forEach(F&& f) const
+    {
+        size_t count = m_size.load(std::memory_order_acquire);
+        for(size_t i = 0; i < count; i++)
+        {
+            const DenseEntry& entry = denseEntry(i);
+            f(entry.universe, *entry.value);
+        }
+    }
+
+private:
+
+    /**
+     * @brief an entry of the dense list
+     *
+     */
+    struct DenseEntry
+    {
+        uint16_t universe;
+        T* value;
+    };
+
+    typedef std::array<std::atomic<T*>, 256> IndexPage;
+    typedef std::array<DenseEntry, 256> DensePage;
+
+    /**
+     * @brief returns the entry at a position of the dense list, which has to be below m_size
+     *
+     */
+    const DenseEntry& denseEntry(size_t position) const
+    {
+        return (*m_dense[position >> 8].load(std::memory_order_acquire))[position & 0xFF];
+    }
+
+    /**
+     * @brief the pages of the index by universe id, selected by the high byte of the id
+     *
+     */
+    std::array<std::atomic<IndexPage*>, 256> m_index{};
+
+    /**
+     * @brief the pages of the dense list, 256 entries each
+     *
+     */
+    std::array<std::atomic<DensePage*>, 256> m_dense{};
+
+    /**
+     * @brief owns the pages of m_index
+     *
+     */
+    std::array<std::unique_ptr<IndexPage>, 256> m_indexPages;
+
+    /**
+     * @brief owns the pages of m_dense
+     *
+     */
+    std::array<std::unique_ptr<DensePage>, 256> m_densePages;
+
+    /**
+     * @brief the number of entries in the dense list
+     *
+     */
+    std::atomic<size_t> m_size{0};
+
+    /**
+     * @brief A mutex serializing insert()
+     *
+     */
+    std::mutex m_insertMutex;
+};
+
+}
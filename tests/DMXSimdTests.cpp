@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include <dmx_simd.hpp>
+#include <dmx_universe_data.hpp>
+#include <random>
+#include <algorithm>
+
+using namespace sACNcpp;
+
+TEST(DMXSimdTests, testKernelsMatchScalar) {    
+    std::mt19937 random(42);
+    std::array<uint8_t, 512> a, b;
+
+    for(int run = 0; run < 1000; run++)
+    {
+        for(uint16_t i = 0; i < 512; i++)
+            a[i] = b[i] = random();
+
+        // change a few random channels, sometimes none
+        int changes = random() % 4;
+        for(int i = 0; i < changes; i++)
+            b[random() % 512]++;
+
+        size_t length = random() % 513;
+
+        EXPECT_EQ (simd::equal(a.data(), b.data(), length), simd::scalar::equal(a.data(), b.data(), length));
+        EXPECT_EQ (simd::firstDifference(a.data(), b.data(), length), simd::scalar::firstDifference(a.data(), b.data(), length));
+        EXPECT_EQ (simd::lastDifference(a.data(), b.data(), length), simd::scalar::lastDifference(a.data(), b.data(), length));
+        EXPECT_TRUE (simd::diff(a.data(), b.data()) == simd::scalar::diff(a.data(), b.data()));
+    }
+}
+
+TEST(DMXSimdTests, testUniverseDiff) {    
+    DMXUniverseData a, b;
+
+    EXPECT_FALSE (a.diff(b).any());
+
+    b.set(0, 1);
+    b.set(63, 1);
+    b.set(64, 1);
+    b.set(511, 1);
+
+    DMXChannelMask mask = a.diff(b);
+
+    EXPECT_EQ (mask.count(), 4u);
+    EXPECT_TRUE (mask.test(0));
+    EXPECT_TRUE (mask.test(63));
+    EXPECT_TRUE (mask.test(64));
+    EXPECT_TRUE (mask.test(511));
+    EXPECT_FALSE (mask.test(1));
+    EXPECT_FALSE (a == b);
+}
+
+TEST(DMXSimdTests, testMaximumMatchesScalar) {    
+    std::array<uint8_t, 512> a, b, expected;
+    for(uint16_t i = 0; i < 512; i++)
+    {
+        a[i] = i * 7;
+        b[i] = i * 13 + 5;
+    }
+
+    expected = a;
+    simd::scalar::maximum(expected.data(), b.data(), 509);
+    simd::maximum(a.data(), b.data(), 509);
+
+    EXPECT_TRUE (a == expected);
+    EXPECT_EQ (a[100], std::max<uint8_t>((uint8_t)(100 * 7), (uint8_t)(100 * 13 + 5)));
+    EXPECT_EQ (a[510], (uint8_t)(510 * 7));
+}
+
+TEST(DMXSimdTests, testPriorityMergeMatchesScalar) {    
+    std::mt19937 random(7);
+
+    for(int run = 0; run < 200; run++)
+    {
+        for(bool highestTakesPrecedence : {true, false})
+        {
+            std::array<uint8_t, 512> levels, priorities, sourceLevels, sourcePriorities;
+            for(uint16_t i = 0; i < 512; i++)
+            {
+                levels[i] = random();
+                sourceLevels[i] = random();
+                // few distinct priorities, so equal priorities are common
+                priorities[i] = random() % 4 * 50;
+                sourcePriorities[i] = random() % 4 * 50;
+            }
+
+            std::array<uint8_t, 512> expectedLevels = levels, expectedPriorities = priorities;
+            simd::scalar::priorityMerge(expectedLevels.data(), expectedPriorities.data(), 
+                sourceLevels.data(), sourcePriorities.data(), 509, highestTakesPrecedence);
+            simd::priorityMerge(levels.data(), priorities.data(), 
+                sourceLevels.data(), sourcePriorities.data(), 509, highestTakesPrecedence);
+
+            ASSERT_TRUE (levels == expectedLevels);
+            ASSERT_TRUE (priorities == expectedPriorities);
+        }
+    }
+}
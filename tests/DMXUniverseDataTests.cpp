@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include <dmx_universe_data.hpp>
+#include <thread>
 
 using namespace sACNcpp;
 
@@ -95,3 +96,149 @@ TEST(DMXUniverseDataTests, testRead24Bit) {
 
     EXPECT_NEAR (data.readVariableResolutionValue(1,3),  1, 1e-5);
 }
+
+TEST(DMXUniverseDataTests, testSeqLockReadWrite) {    
+    DMXUniverseData data(DMXSynchronization::SeqLock);
+
+    data.set(1,127);
+    data.writeVariableResolutionValue(1.0, 10, 2);
+
+    EXPECT_EQ (data[1],  127);
+    EXPECT_EQ (data[10],  255);
+    EXPECT_EQ (data[11],  255);
+
+    DMXUniverseData copy;
+    copy = data;
+
+    EXPECT_TRUE (copy == data);
+}
+
+TEST(DMXUniverseDataTests, testSeqLockConsistentSnapshots) {    
+    DMXUniverseData data(DMXSynchronization::SeqLock);
+    std::atomic_bool running(true);
+
+    std::thread writer([&]() {
+        std::array<uint8_t, 512> frame;
+        for(uint8_t value = 0; running.load(); value++)
+        {
+            frame.fill(value);
+            data.read(frame.data(), 512);
+        }
+    });
+
+    for(int i = 0; i < 10000; i++)
+    {
+        std::array<uint8_t, 512> snapshot = data.values();
+        for(uint16_t j = 1; j < 512; j++)
+            ASSERT_EQ (snapshot[j], snapshot[0]);
+    }
+
+    running.store(false);
+    writer.join();
+}
+
+TEST(DMXUniverseDataTests, testTransaction) {    
+    DMXUniverseData data;
+
+    {
+        auto tx = data.begin();
+        tx[1] = 10;
+        tx[2] = 20;
+        const uint8_t range[] = {1, 2, 3};
+        tx.setRange(100, range, 3);
+        tx.commit();
+    }
+
+    EXPECT_EQ (data[1],  10);
+    EXPECT_EQ (data[2],  20);
+    EXPECT_EQ (data[100],  1);
+    EXPECT_EQ (data[102],  3);
+
+    {
+        auto tx = data.begin();
+        tx[3] = 30;
+    }
+
+    EXPECT_EQ (data[3],  30);
+}
+
+TEST(DMXUniverseDataTests, testSetRange) {    
+    DMXUniverseData data(DMXSynchronization::SeqLock);
+
+    const uint8_t range[] = {5, 6, 7, 8};
+    data.setRange(508, range, 4);
+
+    EXPECT_EQ (data[508],  5);
+    EXPECT_EQ (data[511],  8);
+    EXPECT_THROW (data.setRange(509, range, 4), std::out_of_range);
+}
+
+TEST(DMXUniverseDataTests, testTransactionNoTornFrames) {    
+    DMXUniverseData data(DMXSynchronization::SeqLock);
+    std::atomic_bool running(true);
+
+    std::thread writer([&]() {
+        for(uint8_t value = 0; running.load(); value++)
+        {
+            {
+                auto tx = data.begin();
+                for(uint16_t i = 0; i < 512; i++)
+                    tx[i] = value;
+            }
+            // a writer permanently holding the transaction would starve the readers
+            std::this_thread::yield();
+        }
+    });
+
+    for(int i = 0; i < 10000; i++)
+    {
+        std::array<uint8_t, 512> snapshot = data.values();
+        for(uint16_t j = 1; j < 512; j++)
+            ASSERT_EQ (snapshot[j], snapshot[0]);
+    }
+
+    running.store(false);
+    writer.join();
+}
+
+TEST(DMXUniverseDataTests, testGenerationCountsChanges) {    
+    DMXUniverseData data;
+    uint64_t generation = data.generation();
+
+    data.set(1, 0);
+    EXPECT_EQ (data.generation(), generation);
+
+    data.set(1, 10);
+    EXPECT_EQ (data.generation(), generation+1);
+
+    const uint8_t same[] = {0, 10};
+    data.read(same, 2);
+    EXPECT_EQ (data.generation(), generation+1);
+
+    {
+        auto tx = data.begin();
+        tx[5] = 1;
+        tx[6] = 2;
+    }
+    EXPECT_EQ (data.generation(), generation+2);
+}
+
+TEST(DMXUniverseDataTests, testWriteDirty) {    
+    DMXUniverseData data;
+    std::array<uint8_t, 512> mirror;
+    mirror.fill(0);
+    uint16_t first, last;
+
+    EXPECT_FALSE (data.writeDirty(mirror.data(), first, last));
+
+    data.set(20, 1);
+    data.set(300, 2);
+    data.writeVariableResolutionValue(1.0, 100, 2);
+
+    EXPECT_TRUE (data.writeDirty(mirror.data(), first, last));
+    EXPECT_EQ (first, 20);
+    EXPECT_EQ (last, 301);
+    EXPECT_TRUE (mirror == data.values());
+
+    EXPECT_FALSE (data.writeDirty(mirror.data(), first, last));
+}
@@ -0,0 +1,40 @@
+#include "gtest/gtest.h"
+#include <frame_scheduler.hpp>
+
+using namespace sACNcpp;
+
+TEST(FrameSchedulerTests, testDeadlinesAreEquidistant) {    
+    FrameScheduler scheduler(20);
+    scheduler.start();
+
+    auto last = scheduler.waitForNextFrame();
+    for(int i = 0; i < 5; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(i));
+        auto next = scheduler.waitForNextFrame();
+
+        EXPECT_EQ (next - last, std::chrono::milliseconds(50));
+        last = next;
+    }
+
+    EXPECT_EQ (scheduler.metrics().ticks, 6u);
+    EXPECT_EQ (scheduler.metrics().missedDeadlines, 0u);
+}
+
+TEST(FrameSchedulerTests, testOverrunSkipsDeadlines) {    
+    FrameScheduler scheduler(100);
+    scheduler.start();
+
+    auto first = scheduler.waitForNextFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    auto second = scheduler.waitForNextFrame();
+
+    EXPECT_GE (scheduler.metrics().missedDeadlines, 2u);
+    EXPECT_GE (scheduler.metrics().lastWorkDuration, std::chrono::milliseconds(25));
+    EXPECT_EQ ((second - first) % std::chrono::milliseconds(10), std::chrono::milliseconds(0));
+}
+
+TEST(FrameSchedulerTests, testInvalidFrameRate) {    
+    EXPECT_THROW (FrameScheduler(0), std::invalid_argument);
+    EXPECT_THROW (FrameScheduler(-1), std::invalid_argument);
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include <async_logger.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief a logger keeping all entries
+ */
+class RecordingLogger : public LogInterface
+{
+public:
+    void Log(LogLevel loglevel, std::string text) override
+    {
+        entries.emplace_back(loglevel, text);
+    }
+
+    std::vector<std::pair<LogLevel, std::string>> entries;
+};
+
+/**
+ * @brief restores the logger and the level in use when it was constructed, also if a test returns early
+ */
+class LoggerRestorer
+{
+public:
+    LoggerRestorer() : m_logger(Logger::logger()), m_level(Logger::level()) {}
+
+    ~LoggerRestorer()
+    {
+        Logger::setLogger(m_logger);
+        Logger::setLevel(m_level);
+    }
+
+private:
+    LogInterface* m_logger;
+    LogLevel m_level;
+};
+
+TEST(LoggerTests, testLevelThreshold) {    
+    LoggerRestorer restorer;
+    RecordingLogger logger;
+    Logger::setLogger(&logger);
+    Logger::setLevel(LogLevel::Info);
+
+    int formatted = 0;
+    auto format = [&formatted]() { formatted++; return std::string("text"); };
+
+    SACNCPP_LOG(LogLevel::Debug, format());
+    SACNCPP_LOG(LogLevel::Warning, format());
+    Logger::Log(LogLevel::Debug, "direct");
+
+    EXPECT_EQ (formatted, 1);
+    ASSERT_EQ (logger.entries.size(), 1u);
+    EXPECT_EQ (logger.entries[0].first, LogLevel::Warning);
+    EXPECT_FALSE (Logger::enabled(LogLevel::Debug));
+    EXPECT_TRUE (Logger::enabled(LogLevel::Critical));
+
+    Logger::setLevel(LogLevel::Debug);
+    SACNCPP_LOG(LogLevel::Debug, format());
+    EXPECT_EQ (formatted, 2);
+    EXPECT_EQ (logger.entries.size(), 2u);
+
+    Logger::setLogger(nullptr);
+    EXPECT_FALSE (Logger::enabled(LogLevel::Critical));
+    SACNCPP_LOG(LogLevel::Critical, format());
+    EXPECT_EQ (formatted, 2);
+}
+
+TEST(LoggerTests, testLoggerIsRestored) {    
+    LogInterface* previous = Logger::logger();
+    EXPECT_NE (previous, nullptr);
+    {
+        LoggerRestorer restorer;
+        Logger::setLogger(nullptr);
+        EXPECT_EQ (Logger::logger(), nullptr);
+    }
+    EXPECT_EQ (Logger::logger(), previous);
+}
+
+TEST(LoggerTests, testAsyncLoggerWritesAllEntries) {    
+    std::ostringstream out;
+    {
+        AsyncLogger logger(out, 4096);
+
+        std::vector<std::thread> threads;
+        for(int t = 0; t < 4; t++)
+        {
+            threads.emplace_back([&logger, t]() {
+                for(int i = 0; i < 500; i++)
+                    logger.Log(LogLevel::Info, "thread " + std::to_string(t) + " entry " + std::to_string(i));
+            });
+        }
+        for(std::thread& thread : threads)
+            thread.join();
+
+        logger.flush();
+        EXPECT_EQ (logger.dropped(), 0u);
+    }
+
+    std::string text = out.str();
+    EXPECT_EQ (std::count(text.begin(), text.end(), '\n'), 2000);
+    EXPECT_NE (text.find("[Info] thread 3 entry 499\n"), std::string::npos);
+}
+
+TEST(LoggerTests, testAsyncLoggerDropsWhenFull) {    
+    std::ostringstream out;
+    uint64_t dropped;
+    {
+        AsyncLogger logger(out, 2);
+        for(int i = 0; i < 1000; i++)
+            logger.Log(LogLevel::Warning, std::string(1000, 'x'));
+        dropped = logger.dropped();
+    }
+
+    std::string text = out.str();
+    size_t written = std::count(text.begin(), text.end(), '\n');
+    EXPECT_GT (dropped, 0u);
+    EXPECT_EQ (written + dropped, 1000u);
+    // long texts are truncated
+    EXPECT_LT (text.size(), written * 1000);
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <sacn_capture.hpp>
+#include <cstdio>
+#include <fstream>
+
+using namespace sACNcpp;
+
+/**
+ * @brief a path for a capture file in the temporary directory of the tests
+ */
+static std::string capturePath(const std::string& name)
+{
+    return testing::TempDir() + name;
+}
+
+TEST(sACNCaptureTests, testPacketsSurviveTheRoundTrip) {
+    std::string path = capturePath("roundtrip.sacncap");
+    sACNCID cid = generateCID();
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<sACNPacket> packets;
+    {
+        sACNCaptureWriter writer(path);
+
+        sACNPacket packet(7);
+        packet.setCID(cid);
+        packet.setSourceName("console");
+        packet.setPriority(150);
+        packet.setSyncAddress(9);
+        for(uint16_t i = 0; i < 512; i++)
+            packet.setDMX(i, i * 7);
+
+        for(uint8_t sequence = 0; sequence < 4; sequence++)
+        {
+            packet.setSequenceNumber(sequence);
+            packet.setDMX(sequence * 100, sequence);
+            packet.setDMX(sequence * 100 + 1, sequence);
+            EXPECT_TRUE (writer.write(packet, start + std::chrono::milliseconds(sequence * 10)));
+            packets.push_back(packet);
+        }
+
+        sACNPacket sync = sACNPacket::syncPacket(9);
+        sync.setCID(cid);
+        sync.setSequenceNumber(4);
+        EXPECT_TRUE (writer.write(sync, start + std::chrono::milliseconds(40)));
+        packets.push_back(sync);
+
+        sACNPacket invalid;
+        invalid.getPackedPacket()->root.vector = 0;
+        EXPECT_FALSE (writer.write(invalid, start));
+
+        EXPECT_EQ (writer.packets(), 5u);
+    }
+
+    sACNCaptureReader reader(path);
+    sACNCaptureDecoder decoder;
+    sACNCaptureRecord record;
+    std::vector<sACNCaptureRecordType> types;
+    size_t decoded = 0;
+
+    while(reader.next(record))
+    {
+        types.push_back(record.type);
+        const sACNPacket* packet = decoder.decode(record);
+        if(packet == nullptr)
+            continue;
+
+        ASSERT_LT (decoded, packets.size());
+        const sACNPacket& expected = packets[decoded++];
+        EXPECT_EQ (packet->length(), expected.length());
+        EXPECT_EQ (memcmp(packet->getPackedPacket()->raw, expected.getPackedPacket()->raw, expected.length()), 0);
+    }
+
+    EXPECT_EQ (decoded, packets.size());
+    EXPECT_EQ (reader.position(), reader.size());
+    // the source is declared once, the packets after the first only store the slots that changed
+    EXPECT_EQ (types, (std::vector<sACNCaptureRecordType>{sACNCaptureRecordType::Source, sACNCaptureRecordType::Data,
+        sACNCaptureRecordType::Delta, sACNCaptureRecordType::Delta, sACNCaptureRecordType::Delta, sACNCaptureRecordType::Sync}));
+    // file header, 6 record headers, CID and name, all slots once, then 2 changed slots as one run per delta
+    EXPECT_EQ (reader.size(), 24u + 6 * 23 + 16 + 7 + 512 + 3 * (4 + 2));
+
+    std::remove(path.c_str());
+}
+
+TEST(sACNCaptureTests, testTimestampsAreRelativeToTheStart) {
+    std::string path = capturePath("timestamps.sacncap");
+    {
+        sACNCaptureWriter writer(path);
+        sACNPacket packet(1);
+        writer.write(packet, std::chrono::steady_clock::now() - std::chrono::seconds(1));
+        writer.write(packet, std::chrono::steady_clock::now() + std::chrono::seconds(1));
+    }
+
+    sACNCaptureReader reader(path);
+    sACNCaptureRecord record;
+    ASSERT_TRUE (reader.next(record));
+    EXPECT_EQ (record.type, sACNCaptureRecordType::Source);
+    ASSERT_TRUE (reader.next(record));
+    EXPECT_EQ (record.timestamp, 0u);
+    ASSERT_TRUE (reader.next(record));
+    EXPECT_GE (record.timestamp, 1000000000u);
+    EXPECT_LT (record.timestamp, 2000000000u);
+    EXPECT_FALSE (reader.next(record));
+
+    reader.rewind();
+    EXPECT_TRUE (reader.next(record));
+
+    std::remove(path.c_str());
+}
+
+TEST(sACNCaptureTests, testTruncatedAndInvalidFiles) {
+    std::string path = capturePath("truncated.sacncap");
+    {
+        sACNCaptureWriter writer(path);
+        sACNPacket packet(1);
+        writer.write(packet, std::chrono::steady_clock::now());
+    }
+
+    // cut off the data record, as if the capturing process was killed while writing it
+    std::vector<char> content;
+    {
+        std::ifstream file(path, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size() - 100);
+    }
+
+    sACNCaptureReader reader(path);
+    sACNCaptureRecord record;
+    ASSERT_TRUE (reader.next(record));
+    EXPECT_EQ (record.type, sACNCaptureRecordType::Source);
+    EXPECT_FALSE (reader.next(record));
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "no capture at all, but long enough";
+    }
+    EXPECT_THROW (sACNCaptureReader invalid(path), std::runtime_error);
+    EXPECT_THROW (sACNCaptureReader missing(path + ".missing"), std::runtime_error);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <sacn_frame_queue.hpp>
+#include <sacn_universe_input.hpp>
+#include <thread>
+
+using namespace sACNcpp;
+
+/**
+ * @brief creates a frame of universe 1 with the sequence number and channel 0 set to value
+ */
+static sACNFrame frame(uint8_t value)
+{
+    sACNFrame result;
+    result.universe = 1;
+    result.sequence = value;
+    result.slots = 1;
+    result.data[0] = value;
+    return result;
+}
+
+TEST(sACNFrameQueueTests, testDropNewest) {
+    sACNFrameQueue queue(3, sACNOverflowPolicy::DropNewest);
+    EXPECT_EQ (queue.capacity(), 4u);
+
+    for(uint8_t i = 0; i < 6; i++)
+        EXPECT_EQ (queue.push(frame(i)), i < 4);
+
+    EXPECT_EQ (queue.size(), 4u);
+    EXPECT_EQ (queue.overflows(), 2u);
+
+    sACNFrame result;
+    for(uint8_t i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE (queue.pop(result));
+        EXPECT_EQ (result.sequence, i);
+    }
+    EXPECT_FALSE (queue.pop(result));
+
+    EXPECT_THROW (sACNFrameQueue(0), std::invalid_argument);
+}
+
+TEST(sACNFrameQueueTests, testDropOldest) {
+    sACNFrameQueue queue(4, sACNOverflowPolicy::DropOldest);
+
+    for(uint8_t i = 0; i < 6; i++)
+        EXPECT_TRUE (queue.push(frame(i)));
+
+    EXPECT_EQ (queue.size(), 4u);
+    EXPECT_EQ (queue.overflows(), 2u);
+
+    sACNFrame result;
+    for(uint8_t i = 2; i < 6; i++)
+    {
+        ASSERT_TRUE (queue.pop(result));
+        EXPECT_EQ (result.sequence, i);
+        EXPECT_EQ (result.data[0], i);
+    }
+    EXPECT_FALSE (queue.pop(result));
+}
+
+TEST(sACNFrameQueueTests, testConcurrentFramesStayInOrder) {
+    for(sACNOverflowPolicy policy : {sACNOverflowPolicy::DropOldest, sACNOverflowPolicy::DropNewest})
+    {
+        sACNFrameQueue queue(16, policy);
+        const uint32_t count = 100000;
+
+        std::thread producer([&queue, count]() {
+            for(uint32_t i = 0; i < count; i++)
+            {
+                queue.pushInPlace([i](sACNFrame& slot) {
+                    slot.slots = 4;
+                    memcpy(slot.data.data(), &i, sizeof(i));
+                });
+            }
+        });
+
+        uint64_t received = 0;
+        int64_t last = -1;
+        sACNFrame result;
+        while(true)
+        {
+            if(!queue.pop(result))
+            {
+                if(received + queue.overflows() == count)
+                    break;
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint32_t value;
+            memcpy(&value, result.data.data(), sizeof(value));
+            EXPECT_GT ((int64_t)value, last);
+            last = value;
+            received++;
+        }
+
+        producer.join();
+        EXPECT_EQ (received + queue.overflows(), count);
+    }
+}
+
+TEST(sACNFrameQueueTests, testUniverseInputQueuesAcceptedFrames) {
+    sACNUniverseInput input(DMXSynchronization::Mutex, DMXMergeMode::HTP, 3);
+    auto queue = std::make_shared<sACNFrameQueue>(8);
+    input.setFrameQueue(queue);
+
+    auto now = std::chrono::steady_clock::now();
+    sACNCID cid = generateCID();
+    sACNPacket packet(3);
+    packet.setCID(cid);
+    packet.setPriority(120);
+    packet.setDMX(10, 42);
+    packet.setSequenceNumber(5);
+    input.handleNewPacket(packet, now);
+    // a duplicate is not queued
+    input.handleNewPacket(packet, now);
+
+    sACNFrame result;
+    ASSERT_TRUE (queue->pop(result));
+    EXPECT_EQ (result.universe, 3);
+    EXPECT_EQ (result.cid, cid);
+    EXPECT_EQ (result.priority, 120);
+    EXPECT_EQ (result.sequence, 5);
+    EXPECT_EQ (result.slots, 512);
+    EXPECT_EQ (result.data[10], 42);
+    EXPECT_TRUE (result.received == now);
+    EXPECT_FALSE (queue->pop(result));
+}
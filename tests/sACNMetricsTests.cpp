@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+#include <sacn_metrics.hpp>
+#include <sacn_universe_output.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace sACNcpp;
+
+TEST(sACNMetricsTests, testSnapshotAndCollectors) {    
+    sACNMetricsRegistry registry;
+    EXPECT_EQ (registry.find(5), nullptr);
+
+    registry.universe(5).received(638);
+    registry.universe(5).received(638);
+    registry.universe(2).invalidPackets.fetch_add(1);
+    registry.invalidPacket();
+    registry.syncPacketSent();
+
+    size_t collector = registry.addCollector([](sACNMetricsSnapshot& snapshot) {
+        snapshot.universe(5).packetsLost += 3;
+        snapshot.universe(9).sources += 1;
+    });
+
+    sACNMetricsSnapshot snapshot = registry.snapshot();
+    ASSERT_EQ (snapshot.universes.size(), 3u);
+    EXPECT_EQ (snapshot.universes[0].universe, 2);
+    EXPECT_EQ (snapshot.universes[1].universe, 5);
+    EXPECT_EQ (snapshot.universes[2].universe, 9);
+    EXPECT_EQ (snapshot.universes[1].packetsReceived, 2u);
+    EXPECT_EQ (snapshot.universes[1].bytesReceived, 1276u);
+    EXPECT_EQ (snapshot.universes[1].packetsLost, 3u);
+    EXPECT_EQ (snapshot.packetsLost(), 3u);
+    EXPECT_EQ (snapshot.invalidPackets, 2u);
+    EXPECT_EQ (snapshot.syncPacketsSent, 1u);
+
+    registry.removeCollector(collector);
+    EXPECT_EQ (registry.snapshot().universes.size(), 2u);
+}
+
+TEST(sACNMetricsTests, testUniverseOutputCountsSends) {    
+    sACNMetricsRegistry registry;
+    sACNUniverseOutput output(1, 5);
+    output.setMetrics(&registry.universe(1));
+    auto now = std::chrono::steady_clock::now();
+
+    EXPECT_NE (output.preparePacket(now), nullptr);
+    output.dmx().set(3, 33);
+    EXPECT_NE (output.preparePacket(now), nullptr);
+    EXPECT_EQ (output.preparePacket(now), nullptr);
+    EXPECT_NE (output.preparePacket(now + std::chrono::milliseconds(200)), nullptr);
+
+    sACNMetricsSnapshot snapshot = registry.snapshot();
+    EXPECT_EQ (snapshot.universes[0].changeSends, 1u);
+    EXPECT_EQ (snapshot.universes[0].keepaliveSends, 2u);
+}
+
+TEST(sACNMetricsTests, testPrometheusExport) {    
+    sACNMetricsRegistry registry;
+    registry.universe(7).sent(638);
+    registry.addCollector([](sACNMetricsSnapshot& snapshot) {
+        FrameSchedulerMetrics loop;
+        loop.ticks = 10;
+        loop.maxWorkDuration = std::chrono::milliseconds(2);
+        snapshot.sendLoops.push_back(loop);
+    });
+
+    std::string text = registry.snapshot().toPrometheus();
+    EXPECT_NE (text.find("# TYPE sacn_universe_packets_sent_total counter\n"), std::string::npos);
+    EXPECT_NE (text.find("sacn_universe_packets_sent_total{universe=\"7\"} 1\n"), std::string::npos);
+    EXPECT_NE (text.find("sacn_universe_bytes_sent_total{universe=\"7\"} 638\n"), std::string::npos);
+    EXPECT_NE (text.find("sacn_send_frames_total{worker=\"0\"} 10\n"), std::string::npos);
+    EXPECT_NE (text.find("sacn_send_loop_max_seconds{worker=\"0\"} 0.002\n"), std::string::npos);
+
+    std::string path = testing::TempDir() + "sacn_metrics_test.prom";
+    ASSERT_TRUE (registry.writePrometheus(path));
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ (content.str(), text);
+    std::remove(path.c_str());
+}
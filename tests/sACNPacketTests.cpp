@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include <sacn_packet.hpp>
+#include <sacn_packet_pool.hpp>
+#include <vector>
+
+using namespace sACNcpp;
+
+TEST(sACNPacketTests, testCopyAndMove) {    
+    sACNPacket packet(7);
+    packet.setDMX(10, 100);
+    packet.setSourceName("copy");
+
+    sACNPacket copy(packet);
+    copy.setDMX(10, 50);
+
+    EXPECT_EQ (packet.dmx(10), 100);
+    EXPECT_EQ (copy.dmx(10), 50);
+    EXPECT_EQ (copy.universe(), 7);
+    EXPECT_EQ (copy.sourceName(), "copy");
+
+    sACNPacket moved(std::move(copy));
+    EXPECT_EQ (moved.dmx(10), 50);
+    EXPECT_TRUE (moved.valid());
+
+    std::vector<sACNPacket> packets(4);
+    packets.push_back(packet);
+    EXPECT_EQ (packets[4].universe(), 7);
+    EXPECT_EQ ((uint8_t*)packets[1].getPackedPacket() - (uint8_t*)packets[0].getPackedPacket(), (long)sizeof(sACNPacket));
+}
+
+TEST(sACNPacketTests, testPool) {    
+    sACNPacketPool pool(2);
+
+    {
+        sACNPacketPool::Pointer a = pool.acquire();
+        sACNPacketPool::Pointer b = pool.acquire();
+
+        ASSERT_TRUE (a);
+        ASSERT_TRUE (b);
+        EXPECT_NE (a.get(), b.get());
+        EXPECT_FALSE (pool.acquire());
+        EXPECT_EQ (pool.available(), 0u);
+    }
+
+    EXPECT_EQ (pool.available(), 2u);
+    EXPECT_TRUE (pool.acquire());
+}
+
+TEST(sACNPacketTests, testSyncPacket) {    
+    sACNPacket sync = sACNPacket::syncPacket(7000);
+    sync.setSequenceNumber(12);
+
+    EXPECT_TRUE (sync.isSyncPacket());
+    EXPECT_TRUE (sync.validSync());
+    EXPECT_FALSE (sync.valid());
+    EXPECT_EQ (sync.length(), 49u);
+    EXPECT_EQ (sync.syncAddress(), 7000);
+    EXPECT_EQ (sync.destinationUniverse(), 7000);
+    EXPECT_EQ (sync.sequenceNumber(), 12);
+    EXPECT_EQ (sync.getPackedPacket()->raw[38 + 6], 12);
+    EXPECT_THROW (sync.setSyncAddress(0), std::invalid_argument);
+
+    sACNPacket data(3);
+    data.setSyncAddress(7000);
+
+    EXPECT_FALSE (data.isSyncPacket());
+    EXPECT_TRUE (data.valid());
+    EXPECT_EQ (data.length(), 638u);
+    EXPECT_EQ (data.syncAddress(), 7000);
+    EXPECT_EQ (data.destinationUniverse(), 3);
+}
+
+TEST(sACNPacketTests, testStartCode) {    
+    sACNPacket packet(1);
+    packet.setDMX(0, 42);
+
+    EXPECT_EQ (packet.startCode(), E131_START_CODE_DMX);
+    EXPECT_EQ (packet.getPackedPacket()->dmp.prop_val[1], 42);
+
+    packet.setStartCode(E131_START_CODE_PER_ADDRESS_PRIORITY);
+    EXPECT_EQ (packet.startCode(), 0xDD);
+    EXPECT_EQ (packet.dmx(0), 42);
+
+    DMXUniverseData data;
+    packet.getDMXDataCopy(data);
+    EXPECT_EQ (data[0], 42);
+
+    packet.getPackedPacket()->dmp.prop_val_cnt = htons(2000);
+    EXPECT_EQ (packet.numDMXSlots(), 512);
+    packet.getPackedPacket()->dmp.prop_val_cnt = 0;
+    EXPECT_EQ (packet.numDMXSlots(), 0);
+}
+
+TEST(sACNPacketTests, testChannelRange) {    
+    sACNPacket packet(1);
+    packet.setDMX(511, 7);
+
+    EXPECT_EQ (packet.dmx(511), 7);
+    EXPECT_EQ (packet.getPackedPacket()->dmp.prop_val[512], 7);
+    EXPECT_THROW (packet.setDMX(512, 1), std::out_of_range);
+    EXPECT_THROW (packet.dmx(512), std::out_of_range);
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include <sacn_packet_view.hpp>
+
+using namespace sACNcpp;
+
+TEST(sACNPacketViewTests, testDataPacket) {
+    sACNPacket packet(42, 100);
+    sACNCID cid = generateCID();
+    packet.setCID(cid);
+    packet.setSourceName("console");
+    packet.setPriority(150);
+    packet.setSequenceNumber(7);
+    packet.setSyncAddress(3);
+    packet.setStreamTerminated(true);
+    packet.setDMX(99, 255);
+
+    sACNPacketView view(packet, packet.length());
+    ASSERT_TRUE (view.valid());
+    EXPECT_FALSE (view.validSync());
+    EXPECT_EQ (view.length(), packet.length());
+    EXPECT_EQ (view.cid(), cid);
+    EXPECT_EQ (view.sourceName(), "console");
+    EXPECT_EQ (view.universe(), 42);
+    EXPECT_EQ (view.priority(), 150);
+    EXPECT_EQ (view.sequenceNumber(), 7);
+    EXPECT_EQ (view.syncAddress(), 3);
+    EXPECT_TRUE (view.streamTerminated());
+    EXPECT_EQ (view.startCode(), E131_START_CODE_DMX);
+    EXPECT_EQ (view.numDMXSlots(), 100);
+    EXPECT_EQ (view.slotData(), packet.slotData());
+
+    DMXUniverseData data;
+    view.getDMXDataCopy(data);
+    EXPECT_EQ (data[99], 255);
+
+    // the view does not copy, it reads the datagram in place
+    packet.setDMX(0, 17);
+    EXPECT_EQ (view.slotData()[0], 17);
+}
+
+TEST(sACNPacketViewTests, testSyncPacket) {
+    sACNPacket packet = sACNPacket::syncPacket(12);
+    packet.setSequenceNumber(9);
+
+    sACNPacketView view(packet, packet.length());
+    ASSERT_TRUE (view.validSync());
+    EXPECT_FALSE (view.valid());
+    EXPECT_EQ (view.syncAddress(), 12);
+    EXPECT_EQ (view.sequenceNumber(), 9);
+    EXPECT_EQ (view.universe(), 0);
+    EXPECT_EQ (view.numDMXSlots(), 0);
+    EXPECT_EQ (view.slotData(), nullptr);
+
+    EXPECT_FALSE (sACNPacketView(packet, packet.length() - 1).validSync());
+    EXPECT_FALSE (sACNPacketView(packet, packet.length() + 1).validSync());
+}
+
+TEST(sACNPacketViewTests, testLengthsHaveToMatchTheDatagram) {
+    sACNPacket packet(1, 512);
+    ASSERT_TRUE (sACNPacketView(packet, packet.length()).valid());
+
+    // a datagram cut short, while the buffer still holds the rest of an earlier packet
+    EXPECT_FALSE (sACNPacketView(packet, packet.length() - 1).valid());
+    EXPECT_FALSE (sACNPacketView(packet, 125).valid());
+    EXPECT_FALSE (sACNPacketView(packet, 0).valid());
+    EXPECT_FALSE (sACNPacketView(nullptr, 0).valid());
+
+    // trailing bytes behind the root layer
+    sACNPacket shorter(1, 100);
+    EXPECT_FALSE (sACNPacketView(shorter, shorter.length() + 1).valid());
+
+    // a property value count beyond the datagram and the 513 property values
+    sACNPacket counted(packet);
+    counted.getPackedPacket()->dmp.prop_val_cnt = htons(600);
+    EXPECT_FALSE (sACNPacketView(counted, counted.length()).valid());
+    EXPECT_TRUE (counted.valid());
+
+    // each layer has to cover exactly the rest of the datagram
+    sACNPacket framing(packet);
+    framing.getPackedPacket()->frame.flength = htons(0x7000 | 100);
+    EXPECT_FALSE (sACNPacketView(framing, framing.length()).valid());
+
+    sACNPacket dmp(packet);
+    dmp.getPackedPacket()->dmp.flength = htons(0x7000 | 100);
+    EXPECT_FALSE (sACNPacketView(dmp, dmp.length()).valid());
+
+    sACNPacket flags(packet);
+    flags.getPackedPacket()->root.flength = htons(0x0FFF & ntohs(flags.getPackedPacket()->root.flength));
+    EXPECT_FALSE (sACNPacketView(flags, packet.length()).valid());
+
+    // a packet without any slots, but with a start code, is complete
+    sACNPacket empty(1, 0);
+    sACNPacketView view(empty, empty.length());
+    EXPECT_TRUE (view.valid());
+    EXPECT_EQ (view.numDMXSlots(), 0);
+}
+
+TEST(sACNPacketViewTests, testVectorsAreChecked) {
+    sACNPacket packet(1);
+
+    sACNPacket root(packet);
+    root.getPackedPacket()->root.vector = htonl(5);
+    EXPECT_FALSE (sACNPacketView(root, root.length()).valid());
+
+    sACNPacket frame(packet);
+    frame.getPackedPacket()->frame.vector = htonl(5);
+    EXPECT_FALSE (sACNPacketView(frame, frame.length()).valid());
+
+    sACNPacket dmp(packet);
+    dmp.getPackedPacket()->dmp.type = 0;
+    EXPECT_FALSE (sACNPacketView(dmp, dmp.length()).valid());
+
+    sACNPacket pid(packet);
+    pid.getPackedPacket()->root.acn_pid[0] = 0;
+    EXPECT_FALSE (sACNPacketView(pid, pid.length()).valid());
+    EXPECT_EQ (sACNPacketView(pid, pid.length()).cid(), sACNCID{});
+}
@@ -0,0 +1,273 @@
+#include "gtest/gtest.h"
+#include <sacn_universe_input.hpp>
+
+using namespace sACNcpp;
+
+TEST(sACNUniverseInputTests, testStagedDataIsPublishedOnSync) {    
+    sACNUniverseInput input;
+    sACNPacket packet(1);
+    packet.setSyncAddress(100);
+
+    packet.setDMX(5, 50);
+    EXPECT_TRUE (input.stagePacket(packet));
+    packet.setDMX(5, 60);
+    packet.setSequenceNumber(1);
+    EXPECT_FALSE (input.stagePacket(packet));
+
+    EXPECT_EQ (input.dmx()[5], 0);
+
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_TRUE (input.publishStaged(now));
+    EXPECT_EQ (input.dmx()[5], 60);
+    EXPECT_TRUE (input.lastPublished() == now);
+
+    EXPECT_FALSE (input.publishStaged());
+}
+
+/**
+ * @brief creates the next packet of a source, with channel 0 set to value
+ */
+static sACNPacket sourcePacket(uint8_t sourceId, uint8_t priority, uint8_t value)
+{
+    static std::array<uint8_t, 256> sequenceNumbers{};
+
+    sACNPacket packet(1);
+    packet.setSequenceNumber(sequenceNumbers[sourceId]++);
+    sACNCID cid{};
+    cid[0] = sourceId;
+    packet.setCID(cid);
+    packet.setSourceName("source " + std::to_string(sourceId));
+    packet.setPriority(priority);
+    packet.setDMX(0, value);
+    packet.setDMX(1, 255 - value);
+    return packet;
+}
+
+TEST(sACNUniverseInputTests, testStagedDataIsHeldBackFromUnsynchronizedSources) {    
+    sACNUniverseInput input(DMXSynchronization::Mutex, DMXMergeMode::HTP);
+    auto now = std::chrono::steady_clock::now();
+
+    input.handleNewPacket(sourcePacket(7, 100, 10), now);
+    input.handleNewPacket(sourcePacket(8, 100, 20), now);
+
+    sACNPacket synchronized = sourcePacket(7, 100, 10);
+    synchronized.setSyncAddress(100);
+    synchronized.setDMX(10, 99);
+    EXPECT_TRUE (input.stagePacket(synchronized, now));
+
+    // a packet of the unsynchronized source merges the published data of the synchronized one, not its staged data
+    input.handleNewPacket(sourcePacket(8, 100, 30), now);
+    EXPECT_EQ (input.dmx()[0], 30);
+    EXPECT_EQ (input.dmx()[10], 0);
+
+    EXPECT_TRUE (input.publishStaged(now));
+    EXPECT_EQ (input.dmx()[10], 99);
+    EXPECT_EQ (input.dmx()[0], 30);
+
+    input.handleNewPacket(sourcePacket(8, 100, 40), now);
+    EXPECT_EQ (input.dmx()[10], 99);
+    EXPECT_EQ (input.dmx()[0], 40);
+}
+
+TEST(sACNUniverseInputTests, testHighestPriorityWins) {    
+    sACNUniverseInput input;
+    auto now = std::chrono::steady_clock::now();
+
+    input.handleNewPacket(sourcePacket(1, 100, 10), now);
+    input.handleNewPacket(sourcePacket(2, 120, 20), now);
+    input.handleNewPacket(sourcePacket(1, 100, 30), now);
+
+    EXPECT_EQ (input.sourceCount(), 2u);
+    EXPECT_EQ (input.dmx()[0], 20);
+    EXPECT_EQ (input.currentDMXSource(), "source 2");
+}
+
+TEST(sACNUniverseInputTests, testHTPAndLTPMerge) {    
+    sACNUniverseInput input(DMXSynchronization::Mutex, DMXMergeMode::HTP);
+    auto now = std::chrono::steady_clock::now();
+
+    input.handleNewPacket(sourcePacket(1, 100, 10), now);
+    input.handleNewPacket(sourcePacket(2, 100, 20), now);
+
+    EXPECT_EQ (input.dmx()[0], 20);
+    EXPECT_EQ (input.dmx()[1], 245);
+
+    input.setMergeMode(DMXMergeMode::LTP);
+    input.handleNewPacket(sourcePacket(1, 100, 10), now);
+
+    EXPECT_EQ (input.dmx()[0], 10);
+    EXPECT_EQ (input.dmx()[1], 245);
+    EXPECT_EQ (input.currentDMXSource(), "source 1");
+}
+
+TEST(sACNUniverseInputTests, testSourcesTimeOutAndTerminate) {    
+    sACNUniverseInput input;
+    auto now = std::chrono::steady_clock::now();
+
+    input.handleNewPacket(sourcePacket(1, 150, 10), now);
+    input.handleNewPacket(sourcePacket(2, 100, 20), now + std::chrono::seconds(2));
+    EXPECT_EQ (input.dmx()[0], 10);
+
+    // source 1 timed out
+    input.handleNewPacket(sourcePacket(2, 100, 20), now + std::chrono::seconds(3));
+    EXPECT_EQ (input.sourceCount(), 1u);
+    EXPECT_EQ (input.dmx()[0], 20);
+
+    input.handleNewPacket(sourcePacket(3, 100, 30), now + std::chrono::seconds(3));
+    sACNPacket terminated = sourcePacket(3, 100, 0);
+    terminated.setStreamTerminated(true);
+    input.handleNewPacket(terminated, now + std::chrono::seconds(3));
+
+    EXPECT_EQ (input.sourceCount(), 1u);
+    EXPECT_EQ (input.dmx()[0], 20);
+    EXPECT_EQ (input.dmx()[1], 235);
+}
+
+TEST(sACNUniverseInputTests, testShorterSourceClearsChannels) {    
+    sACNUniverseInput input;
+    auto now = std::chrono::steady_clock::now();
+
+    sACNPacket full = sourcePacket(4, 150, 10);
+    full.setDMX(300, 200);
+    input.handleNewPacket(full, now);
+    sACNPacket shorter = sourcePacket(5, 100, 20);
+    shorter.setNumDMXSlots(100);
+    shorter.setDMX(99, 99);
+    input.handleNewPacket(shorter, now);
+    input.handleNewPacket(sourcePacket(6, 50, 30), now);
+    EXPECT_EQ (input.dmx()[300], 200);
+
+    // the source with 100 slots takes over, the channels behind them are cleared
+    sACNPacket terminated = sourcePacket(4, 150, 10);
+    terminated.setStreamTerminated(true);
+    input.handleNewPacket(terminated, now);
+
+    EXPECT_EQ (input.dmx()[0], 20);
+    EXPECT_EQ (input.dmx()[99], 99);
+    EXPECT_EQ (input.dmx()[300], 0);
+
+    // source 5 times out, the 512 slots of source 6 are published again
+    sACNPacket longer = sourcePacket(6, 50, 30);
+    longer.setDMX(300, 7);
+    input.handleNewPacket(longer, now + std::chrono::seconds(1));
+    EXPECT_EQ (input.dmx()[0], 20);
+    input.handleNewPacket(sourcePacket(6, 50, 30), now + std::chrono::seconds(3));
+    EXPECT_EQ (input.sourceCount(), 1u);
+    EXPECT_EQ (input.dmx()[0], 30);
+    EXPECT_EQ (input.dmx()[99], 0);
+}
+
+TEST(sACNUniverseInputTests, testPerAddressPriority) {    
+    sACNUniverseInput input;
+    auto now = std::chrono::steady_clock::now();
+
+    input.handleNewPacket(sourcePacket(1, 100, 10), now);
+    input.handleNewPacket(sourcePacket(2, 100, 20), now);
+
+    // source 1 takes channel 0 with a higher priority, and releases channel 1
+    sACNPacket priorities = sourcePacket(1, 100, 0);
+    priorities.setStartCode(E131_START_CODE_PER_ADDRESS_PRIORITY);
+    for(uint16_t channel = 0; channel < 512; channel++)
+        priorities.setDMX(channel, 100);
+    priorities.setDMX(0, 150);
+    priorities.setDMX(1, 0);
+    input.handleNewPacket(priorities, now);
+
+    EXPECT_EQ (input.dmx()[0], 10);
+    EXPECT_EQ (input.dmx()[1], 235);
+    EXPECT_EQ (input.slotPriorities()[0], 150);
+    EXPECT_EQ (input.slotPriorities()[1], 100);
+
+    // levels are not overwritten by priority packets
+    EXPECT_EQ (input.dmx()[2], 0);
+
+    sACNPacket text = sourcePacket(2, 100, 99);
+    text.setStartCode(0x17);
+    input.handleNewPacket(text, now);
+    EXPECT_EQ (input.dmx()[0], 10);
+
+    // the text packet took a sequence number of source 2, its next DMX packet follows without a gap
+    input.handleNewPacket(sourcePacket(2, 100, 30), now);
+    EXPECT_EQ (input.dmx()[1], 225);
+    EXPECT_EQ (input.statistics().gaps, 0u);
+    EXPECT_EQ (input.statistics().lost, 0u);
+}
+
+TEST(sACNUniverseInputTests, testSequenceNumbers) {    
+    sACNUniverseInput input;
+    auto now = std::chrono::steady_clock::now();
+    sACNPacket packet = sourcePacket(10, 100, 0);
+
+    auto receive = [&](uint8_t sequence, uint8_t value) {
+        packet.setSequenceNumber(sequence);
+        packet.setDMX(0, value);
+        input.handleNewPacket(packet, now);
+    };
+
+    receive(250, 1);
+    receive(251, 2);
+    receive(251, 3);    // duplicate
+    receive(249, 4);    // late
+    receive(254, 5);    // 252 and 253 lost
+    receive(3, 6);      // wraps around, 255 to 2 lost
+    EXPECT_EQ (input.dmx()[0], 6);
+    receive(200, 7);    // far behind, taken as a restart
+    EXPECT_EQ (input.dmx()[0], 7);
+
+    // an alternate start code packet in between is counted, but not merged
+    packet.setStartCode(0x17);
+    receive(201, 8);
+    packet.setStartCode(E131_START_CODE_DMX);
+    receive(202, 9);
+    EXPECT_EQ (input.dmx()[0], 9);
+
+    sACNUniverseStatistics statistics = input.statistics();
+    EXPECT_EQ (statistics.accepted, 7u);
+    EXPECT_EQ (statistics.duplicates, 1u);
+    EXPECT_EQ (statistics.outOfOrder, 1u);
+    EXPECT_EQ (statistics.gaps, 2u);
+    EXPECT_EQ (statistics.lost, 6u);
+    EXPECT_DOUBLE_EQ (statistics.lossRate(), 6.0 / 13.0);
+
+    input.resetStatistics();
+    EXPECT_EQ (input.statistics().accepted, 0u);
+}
+
+TEST(sACNUniverseInputTests, testChangeSubscription) {    
+    sACNUniverseInput input(DMXSynchronization::Mutex, DMXMergeMode::HTP, 7);
+    auto now = std::chrono::steady_clock::now();
+
+    std::vector<DMXChangeEvent> events;
+    size_t subscription = input.subscribe([&](const DMXChangeEvent& event) { 
+        events.push_back(event); 
+        EXPECT_EQ (input.sourceCount(), 1u);
+    });
+
+    input.handleNewPacket(sourcePacket(20, 100, 10), now);
+    ASSERT_EQ (events.size(), 1u);
+    EXPECT_EQ (events[0].universe, 7);
+    EXPECT_EQ (events[0].changed.count(), 2u);
+    EXPECT_TRUE (events[0].changed.test(0));
+    EXPECT_TRUE (events[0].changed.test(1));
+    EXPECT_TRUE (events[0].received == now);
+
+    // the same values again are not a change
+    input.handleNewPacket(sourcePacket(20, 100, 10), now);
+    EXPECT_EQ (events.size(), 1u);
+
+    sACNPacket packet = sourcePacket(20, 100, 10);
+    packet.setDMX(300, 1);
+    input.handleNewPacket(packet, now);
+    ASSERT_EQ (events.size(), 2u);
+    EXPECT_EQ (events[1].changed.count(), 1u);
+    EXPECT_TRUE (events[1].changed.test(300));
+
+    std::vector<uint16_t> channels;
+    events[0].changed.forEach([&](uint16_t channel) { channels.push_back(channel); });
+    EXPECT_EQ (channels, std::vector<uint16_t>({0, 1}));
+
+    EXPECT_TRUE (input.unsubscribe(subscription));
+    EXPECT_FALSE (input.unsubscribe(subscription));
+    input.handleNewPacket(sourcePacket(20, 100, 50), now);
+    EXPECT_EQ (events.size(), 2u);
+}
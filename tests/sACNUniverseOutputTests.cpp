@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include <sacn_universe_output.hpp>
+
+using namespace sACNcpp;
+
+TEST(sACNUniverseOutputTests, testPreparedPacketHeaders) {    
+    sACNUniverseOutput output(42);
+    sACNCID cid = generateCID();
+    output.setCID(cid);
+    output.setSourceName("test source");
+    output.setPriority(150);
+
+    const sACNPacket* packet = output.preparePacket();
+
+    ASSERT_NE (packet, nullptr);
+    EXPECT_TRUE (packet->valid());
+    EXPECT_EQ (packet->universe(), 42);
+    EXPECT_EQ (packet->priority(), 150);
+    EXPECT_EQ (packet->sourceName(), "test source");
+    EXPECT_TRUE (packet->cid() == cid);
+    EXPECT_EQ (packet->numDMXSlots(), 512);
+}
+
+TEST(sACNUniverseOutputTests, testOnlyChangesAndKeepalivesAreSent) {    
+    sACNUniverseOutput output(1, 5);
+    auto now = std::chrono::steady_clock::now();
+
+    const sACNPacket* first = output.preparePacket(now);
+    ASSERT_NE (first, nullptr);
+    uint8_t sequence = first->sequenceNumber();
+
+    EXPECT_EQ (output.preparePacket(now), nullptr);
+
+    output.dmx().set(3, 33);
+    output.dmx().set(400, 44);
+    const sACNPacket* changed = output.preparePacket(now);
+
+    ASSERT_NE (changed, nullptr);
+    EXPECT_EQ (changed->dmx(3), 33);
+    EXPECT_EQ (changed->dmx(400), 44);
+    EXPECT_EQ (changed->sequenceNumber(), uint8_t(sequence+1));
+
+    EXPECT_EQ (output.preparePacket(now + std::chrono::milliseconds(100)), nullptr);
+
+    const sACNPacket* keepalive = output.preparePacket(now + std::chrono::milliseconds(200));
+    ASSERT_NE (keepalive, nullptr);
+    EXPECT_EQ (keepalive->dmx(400), 44);
+    EXPECT_EQ (keepalive->sequenceNumber(), uint8_t(sequence+2));
+}
+
+TEST(sACNUniverseOutputTests, testInvalidUniverse) {    
+    EXPECT_THROW (sACNUniverseOutput(0), std::invalid_argument);
+    EXPECT_THROW (sACNUniverseOutput(64000), std::invalid_argument);
+}
+
+TEST(sACNUniverseOutputTests, testSyncAddress) {    
+    sACNUniverseOutput output(5);
+    EXPECT_EQ (output.syncAddress(), 0);
+
+    output.setSyncAddress(900);
+    const sACNPacket* packet = output.preparePacket();
+
+    ASSERT_NE (packet, nullptr);
+    EXPECT_EQ (output.syncAddress(), 900);
+    EXPECT_EQ (packet->syncAddress(), 900);
+    EXPECT_EQ (packet->universe(), 5);
+}
+
+TEST(sACNUniverseOutputTests, testHeadersChangeWithTheNextPacket) {    
+    sACNUniverseOutput output(6, 5);
+    output.setPriority(100);
+    auto now = std::chrono::steady_clock::now();
+
+    const sACNPacket* packet = output.preparePacket(now);
+    ASSERT_NE (packet, nullptr);
+    EXPECT_EQ (packet->priority(), 100);
+
+    // the packet may still be sent, it is left as it is until the next one is prepared
+    output.setPriority(150);
+    output.setSourceName("renamed");
+    output.setSyncAddress(12);
+    EXPECT_EQ (packet->priority(), 100);
+    EXPECT_EQ (packet->syncAddress(), 0);
+    EXPECT_EQ (output.syncAddress(), 12);
+
+    output.dmx().set(0, 1);
+    packet = output.preparePacket(now);
+    ASSERT_NE (packet, nullptr);
+    EXPECT_EQ (packet->priority(), 150);
+    EXPECT_EQ (packet->sourceName(), "renamed");
+    EXPECT_EQ (packet->syncAddress(), 12);
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include <sacn_universe_table.hpp>
+#include <thread>
+#include <vector>
+
+using namespace sACNcpp;
+
+TEST(sACNUniverseTableTests, testInsertAndFind) {    
+    sACNUniverseTable<int> table;
+
+    EXPECT_EQ (table.find(1), nullptr);
+    EXPECT_TRUE (table.insert(1, std::make_unique<int>(10)));
+    EXPECT_TRUE (table.insert(63999, std::make_unique<int>(20)));
+    EXPECT_FALSE (table.insert(1, std::make_unique<int>(30)));
+
+    EXPECT_EQ (*table.find(1), 10);
+    EXPECT_EQ (*table.at(63999), 20);
+    EXPECT_EQ (table.find(2), nullptr);
+    EXPECT_EQ (table.find(63998), nullptr);
+    EXPECT_TRUE (table.contains(63999));
+    EXPECT_EQ (table.size(), 2u);
+    EXPECT_THROW (table.at(5), std::out_of_range);
+}
+
+TEST(sACNUniverseTableTests, testForEach) {    
+    sACNUniverseTable<int> table;
+
+    for(uint16_t universe = 1; universe <= 1000; universe++)
+        table.insert(universe * 7 % 64000, std::make_unique<int>(universe));
+
+    std::vector<uint16_t> visited;
+    table.forEach([&visited](uint16_t universe, int& value) {
+        EXPECT_EQ (universe, value * 7 % 64000);
+        visited.push_back(universe);
+    });
+
+    ASSERT_EQ (visited.size(), 1000u);
+    EXPECT_EQ (visited.front(), 7);
+}
+
+TEST(sACNUniverseTableTests, testConcurrentInsertAndLookup) {    
+    sACNUniverseTable<int> table;
+
+    std::thread writer([&table]() {
+        for(int universe = 1; universe <= 10000; universe++)
+            table.insert(universe, std::make_unique<int>(universe));
+    });
+
+    size_t count = 0;
+    while(count < 10000)
+    {
+        count = table.size();
+        size_t visited = 0;
+        table.forEach([&visited](uint16_t universe, int& value) {
+            EXPECT_EQ (universe, value);
+            visited++;
+        });
+        EXPECT_GE (visited, count);
+
+        int* value = table.find(count);
+        if(count > 0)
+        {
+            EXPECT_EQ (*value, (int)count);
+        }
+    }
+
+    writer.join();
+}
@@ -0,0 +1,377 @@
+#include <sacn-cpp.hpp>
+#include <frame_scheduler.hpp>
+#include "tool_options.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sACNcpp;
+
+/**
+ * @brief Generates synthetic sACN traffic to measure the capacity of receivers, see sACN_LoadSink.cpp.
+ *
+ * Every virtual source sends all universes, with its own CID and priority, like several consoles backing
+ * each other up. In every frame, the change ratio of the universes is rewritten with new values for all 512
+ * slots, rotating through the universes; the others are only refreshed at the keep alive rate.
+ * Multicast traffic is sent with one sACNOutput per source, unicast traffic with one sACNSenderSocket per source.
+ */
+
+static std::atomic<bool> running{true};
+
+static void handleSignal(int)
+{
+    running.store(false);
+}
+
+static void usage()
+{
+    std::cout <<
+        "Usage: sacn-loadgen [options]\n"
+        "  --universes N       number of universes sent (default 100)\n"
+        "  --first U           first universe (default 1)\n"
+        "  --rate FPS          frames per second (default 44)\n"
+        "  --change RATIO      fraction of the universes changed per frame, 0 to 1 (default 1)\n"
+        "  --sources S         number of virtual sources sending every universe (default 1)\n"
+        "  --priority P        priority of the first source (default 100)\n"
+        "  --priority-step D   priority added per further source (default 0)\n"
+        "  --workers W         send workers per multicast source (default 1)\n"
+        "  --unicast HOST      send to HOST instead of the multicast groups\n"
+        "  --interface ADDR    the network interface to send from\n"
+        "  --duration SECONDS  stop after SECONDS, 0 runs until interrupted (default 0)\n"
+        "  --report SECONDS    interval of the rate reports (default 1)\n";
+}
+
+/**
+ * @brief A sender of all universes with its own CID and priority
+ *
+ */
+class VirtualSource
+{
+public:
+    virtual ~VirtualSource() {}
+
+    /**
+     * @brief starts sending, returns false if the socket could not be opened
+     *
+     */
+    virtual bool start(const std::string& networkInterface) = 0;
+
+    /**
+     * @brief stops sending
+     *
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief the data of the index-th universe sent
+     *
+     */
+    virtual DMXUniverseData& dmx(size_t index) = 0;
+
+    /**
+     * @brief the number of packets sent so far
+     *
+     */
+    virtual uint64_t packetsSent() = 0;
+
+    /**
+     * @brief the number of frame deadlines missed by the sending threads so far
+     *
+     */
+    virtual uint64_t missedDeadlines() = 0;
+};
+
+/**
+ * @brief A source sending to the multicast groups of the universes through a sACNOutput
+ *
+ */
+class MulticastSource : public VirtualSource
+{
+public:
+    MulticastSource(const std::string& name, uint8_t priority, uint16_t firstUniverse, uint16_t universes,
+        double frameRate, size_t sendWorkers) :
+        m_output(nullptr, 5, frameRate, sendWorkers),
+        m_firstUniverse(firstUniverse)
+    {
+        m_output.setSourceName(name);
+        m_output.setPriority(priority);
+        for(uint16_t i = 0; i < universes; i++)
+            m_output.addUniverse(firstUniverse + i, DMXSynchronization::SeqLock);
+    }
+
+    bool start(const std::string& networkInterface) override
+    {
+        return m_output.start(networkInterface);
+    }
+
+    void stop() override
+    {
+        m_output.stop();
+    }
+
+    DMXUniverseData& dmx(size_t index) override
+    {
+        return m_output[m_firstUniverse + index]->dmx();
+    }
+
+    uint64_t packetsSent() override
+    {
+        return m_output.packetsSent();
+    }
+
+    uint64_t missedDeadlines() override
+    {
+        uint64_t result = 0;
+        for(size_t worker = 0; worker < m_output.sendWorkers(); worker++)
+            result += m_output.frameMetrics(worker).missedDeadlines;
+        return result;
+    }
+
+private:
+    sACNOutput m_output;
+    uint16_t m_firstUniverse;
+};
+
+/**
+ * @brief A source sending all universes to one host, from a thread of its own
+ *
+ */
+class UnicastSource : public VirtualSource
+{
+public:
+    UnicastSource(const std::string& name, uint8_t priority, uint16_t firstUniverse, uint16_t universes,
+        double frameRate, const std::string& host) :
+        m_host(host),
+        m_context(std::make_shared<asio::io_context>()),
+        m_scheduler(frameRate)
+    {
+        sACNCID cid = generateCID();
+        for(uint16_t i = 0; i < universes; i++)
+        {
+            m_universes.push_back(std::make_unique<sACNUniverseOutput>(firstUniverse + i, 5, DMXSynchronization::SeqLock));
+            m_universes.back()->setSourceName(name);
+            m_universes.back()->setCID(cid);
+            m_universes.back()->setPriority(priority);
+        }
+    }
+
+    ~UnicastSource()
+    {
+        stop();
+    }
+
+    bool start(const std::string& networkInterface) override
+    {
+        m_socket = std::make_unique<sACNSenderSocket>(m_context, networkInterface);
+        if(!m_socket->start())
+            return false;
+
+        m_running.store(true);
+        m_thread = std::thread([this]() {
+            m_scheduler.start();
+            while(m_running.load())
+            {
+                FrameScheduler::Clock::time_point now = m_scheduler.waitForNextFrame();
+                for(std::unique_ptr<sACNUniverseOutput>& universe : m_universes)
+                {
+                    const sACNPacket* packet = universe->preparePacket(now);
+                    if(packet != nullptr && m_socket->sendPacketUnicast(*packet, m_host))
+                        m_packetsSent.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        return true;
+    }
+
+    void stop() override
+    {
+        if(!m_running.exchange(false))
+            return;
+        m_thread.join();
+    }
+
+    DMXUniverseData& dmx(size_t index) override
+    {
+        return m_universes[index]->dmx();
+    }
+
+    uint64_t packetsSent() override
+    {
+        return m_packetsSent.load(std::memory_order_relaxed);
+    }
+
+    uint64_t missedDeadlines() override
+    {
+        return m_scheduler.metrics().missedDeadlines;
+    }
+
+private:
+    std::string m_host;
+    std::shared_ptr<asio::io_context> m_context;
+    std::vector<std::unique_ptr<sACNUniverseOutput>> m_universes;
+    std::unique_ptr<sACNSenderSocket> m_socket;
+    FrameScheduler m_scheduler;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_packetsSent{0};
+};
+
+int main(int argc, char** argv)
+{
+    uint16_t universes, firstUniverse;
+    double frameRate, changeRatio, duration, reportInterval;
+    size_t sources, sendWorkers;
+    int priority, priorityStep;
+    std::string unicastHost, networkInterface;
+
+    try
+    {
+        tools::ToolOptions options(argc, argv);
+        if(options.has("help"))
+        {
+            usage();
+            return 0;
+        }
+
+        universes = options.number("universes", 100);
+        firstUniverse = options.number("first", 1);
+        frameRate = options.number("rate", 44);
+        changeRatio = options.number("change", 1);
+        sources = options.number("sources", 1);
+        priority = options.number("priority", 100);
+        priorityStep = options.number("priority-step", 0);
+        sendWorkers = options.number("workers", 1);
+        unicastHost = options.get("unicast", "");
+        networkInterface = options.get("interface", "");
+        duration = options.number("duration", 0);
+        reportInterval = options.number("report", 1);
+
+        if(universes == 0 || firstUniverse == 0 || firstUniverse + universes - 1 > 63999)
+            throw std::invalid_argument("The universes have to be between 1 and 63999.");
+        if(frameRate <= 0 || reportInterval <= 0)
+            throw std::invalid_argument("The frame rate and report interval have to be greater than 0.");
+        if(changeRatio < 0 || changeRatio > 1)
+            throw std::invalid_argument("The change ratio has to be between 0 and 1.");
+        if(sources == 0 || priority < 0 || priority + priorityStep * (int)(sources - 1) > 200 || priorityStep < 0)
+            throw std::invalid_argument("There has to be at least one source, and all priorities have to be between 0 and 200.");
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        usage();
+        return 1;
+    }
+
+    Logger::setLevel(LogLevel::Warning);
+
+    std::vector<std::unique_ptr<VirtualSource>> senders;
+    for(size_t i = 0; i < sources; i++)
+    {
+        std::string name = "sACN-cpp load generator " + std::to_string(i + 1);
+        uint8_t sourcePriority = priority + priorityStep * i;
+
+        if(unicastHost.empty())
+            senders.push_back(std::make_unique<MulticastSource>(name, sourcePriority, firstUniverse, universes, frameRate, sendWorkers));
+        else
+            senders.push_back(std::make_unique<UnicastSource>(name, sourcePriority, firstUniverse, universes, frameRate, unicastHost));
+
+        if(!senders.back()->start(networkInterface))
+        {
+            std::cerr << "Could not open the socket of source " << i + 1 << std::endl;
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "Sending " << universes << " universes from " << sources << " source(s) at " << frameRate
+        << " fps, changing " << changeRatio * 100 << "% per frame, "
+        << (unicastHost.empty() ? std::string("multicast") : "unicast to " + unicastHost) << std::endl;
+
+    // rewrites changeRatio of the universes of every source each frame, rotating through the universes
+    std::thread changer([&]() {
+        FrameScheduler scheduler(frameRate);
+        size_t changedPerFrame = static_cast<size_t>(changeRatio * universes + 0.5);
+        size_t next = 0;
+        uint64_t frame = 0;
+        std::array<uint8_t, 512> values;
+
+        scheduler.start();
+        while(running.load())
+        {
+            scheduler.waitForNextFrame();
+            frame++;
+            for(size_t slot = 0; slot < values.size(); slot++)
+                values[slot] = static_cast<uint8_t>(frame + slot);
+
+            for(size_t i = 0; i < changedPerFrame; i++)
+            {
+                for(std::unique_ptr<VirtualSource>& sender : senders)
+                    sender->dmx(next).read(values.data(), values.size());
+                next = (next + 1) % universes;
+            }
+        }
+    });
+
+    auto packetsSent = [&]() {
+        uint64_t result = 0;
+        for(std::unique_ptr<VirtualSource>& sender : senders)
+            result += sender->packetsSent();
+        return result;
+    };
+    auto missedDeadlines = [&]() {
+        uint64_t result = 0;
+        for(std::unique_ptr<VirtualSource>& sender : senders)
+            result += sender->missedDeadlines();
+        return result;
+    };
+
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last = started;
+    std::clock_t lastCPU = std::clock();
+    uint64_t lastSent = packetsSent();
+    uint64_t lastMissed = missedDeadlines();
+
+    while(running.load())
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(reportInterval));
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::clock_t cpu = std::clock();
+        uint64_t sent = packetsSent();
+        uint64_t missed = missedDeadlines();
+        double elapsed = std::chrono::duration<double>(now - last).count();
+
+        std::printf("%8.1fs  sent %10.0f packets/s  missed deadlines %6llu  cpu %5.1f%%\n",
+            std::chrono::duration<double>(now - started).count(),
+            (sent - lastSent) / elapsed,
+            (unsigned long long)(missed - lastMissed),
+            100.0 * (cpu - lastCPU) / CLOCKS_PER_SEC / elapsed);
+        std::fflush(stdout);
+
+        last = now;
+        lastCPU = cpu;
+        lastSent = sent;
+        lastMissed = missed;
+
+        if(duration > 0 && std::chrono::duration<double>(now - started).count() >= duration)
+            running.store(false);
+    }
+
+    changer.join();
+    for(std::unique_ptr<VirtualSource>& sender : senders)
+        sender->stop();
+
+    std::cout << "Sent " << packetsSent() << " packets" << std::endl;
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <sacn-cpp.hpp>
+#include "tool_options.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace sACNcpp;
+
+/**
+ * @brief Receives the traffic of sACN_LoadGenerator.cpp (or any other source) and reports the received
+ * rate, lost packets (gaps in the sequence numbers), reordered or duplicated packets and the CPU time
+ * spent, in total and per universe. All numbers but the CPU time of the process are taken from the metrics 
+ * registry of the sACNInput. The time the receive workers spent handling packets is attributed to the 
+ * universes by their share of the packets.
+ */
+
+static std::atomic<bool> running{true};
+
+static void handleSignal(int)
+{
+    running.store(false);
+}
+
+static void usage()
+{
+    std::cout <<
+        "Usage: sacn-loadsink [options]\n"
+        "  --universes N       number of universes received (default 100)\n"
+        "  --first U           first universe (default 1)\n"
+        "  --workers W         receive workers (default 1)\n"
+        "  --batch B           packets fetched from a socket at once (default 64)\n"
+        "  --interface ADDR    the network interface to receive on\n"
+        "  --duration SECONDS  stop after SECONDS, 0 runs until interrupted (default 0)\n"
+        "  --report SECONDS    interval of the reports (default 1)\n"
+        "  --per-universe      print the totals of every universe when stopping, with the handling time attributed to it\n"
+        "  --metrics PATH      write the metrics in the Prometheus text format to PATH at every report\n";
+}
+
+/**
+ * @brief the totals over all universes of a snapshot
+ *
+ */
+struct Totals
+{
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t reordered = 0;
+    uint64_t invalid = 0;
+    uint64_t handled = 0;
+    std::chrono::nanoseconds busy{0};
+
+    Totals(const sACNMetricsSnapshot& snapshot)
+    {
+        for(const sACNUniverseMetricsSnapshot& universe : snapshot.universes)
+        {
+            received += universe.packetsReceived;
+            lost += universe.packetsLost;
+            reordered += universe.packetsDropped;
+            invalid += universe.invalidPackets;
+        }
+        invalid += snapshot.invalidPackets;
+
+        for(const sACNReceiveLoopMetrics& loop : snapshot.receiveLoops)
+        {
+            handled += loop.packets;
+            busy += loop.busy;
+        }
+    }
+};
+
+int main(int argc, char** argv)
+{
+    uint16_t universes, firstUniverse;
+    size_t receiveWorkers, batchSize;
+    double duration, reportInterval;
+    bool perUniverse;
+    std::string networkInterface, metricsPath;
+
+    try
+    {
+        tools::ToolOptions options(argc, argv);
+        if(options.has("help"))
+        {
+            usage();
+            return 0;
+        }
+
+        universes = options.number("universes", 100);
+        firstUniverse = options.number("first", 1);
+        receiveWorkers = options.number("workers", 1);
+        batchSize = options.number("batch", 64);
+        networkInterface = options.get("interface", "");
+        duration = options.number("duration", 0);
+        reportInterval = options.number("report", 1);
+        perUniverse = options.has("per-universe");
+        metricsPath = options.get("metrics", "");
+
+        if(universes == 0 || firstUniverse == 0 || firstUniverse + universes - 1 > 63999)
+            throw std::invalid_argument("The universes have to be between 1 and 63999.");
+        if(batchSize == 0 || reportInterval <= 0)
+            throw std::invalid_argument("The batch size and report interval have to be greater than 0.");
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        usage();
+        return 1;
+    }
+
+    Logger::setLevel(LogLevel::Warning);
+
+    sACNInput input(nullptr, batchSize, receiveWorkers);
+    if(!input.start(networkInterface))
+    {
+        std::cerr << "Could not open the receive sockets" << std::endl;
+        return 1;
+    }
+
+    for(uint16_t i = 0; i < universes; i++)
+    {
+        if(!input.addUniverse(firstUniverse + i, DMXSynchronization::SeqLock))
+        {
+            std::cerr << "Could not join universe " << firstUniverse + i << ". On linux, a socket joins at most "
+                "net.ipv4.igmp_max_memberships multicast groups, raise it or use more receive workers." << std::endl;
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "Receiving " << universes << " universes with " << input.receiveWorkers() << " worker(s)" << std::endl;
+
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last = started;
+    std::clock_t startCPU = std::clock();
+    std::clock_t lastCPU = startCPU;
+    Totals previous(input.metrics()->snapshot());
+
+    while(running.load())
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(reportInterval));
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::clock_t cpu = std::clock();
+        Totals current(input.metrics()->snapshot());
+        double elapsed = std::chrono::duration<double>(now - last).count();
+        double cpuSeconds = double(cpu - lastCPU) / CLOCKS_PER_SEC;
+        double busySeconds = std::chrono::duration<double>(current.busy - previous.busy).count();
+        uint64_t received = current.received - previous.received;
+        uint64_t lost = current.lost - previous.lost;
+
+        std::printf("%8.1fs  received %10.0f packets/s  lost %8llu (%.3f%%)  reordered %6llu  invalid %6llu  "
+            "cpu %5.1f%%  handling %.1f us/s (average %.2f us/s per universe)\n",
+            std::chrono::duration<double>(now - started).count(),
+            received / elapsed,
+            (unsigned long long)lost,
+            received + lost == 0 ? 0.0 : 100.0 * lost / (received + lost),
+            (unsigned long long)(current.reordered - previous.reordered),
+            (unsigned long long)(current.invalid - previous.invalid),
+            100.0 * cpuSeconds / elapsed,
+            1e6 * busySeconds / elapsed,
+            1e6 * busySeconds / elapsed / universes);
+        std::fflush(stdout);
+
+        if(!metricsPath.empty() && !input.metrics()->writePrometheus(metricsPath))
+            std::cerr << "Could not write " << metricsPath << std::endl;
+
+        last = now;
+        lastCPU = cpu;
+        previous = current;
+
+        if(duration > 0 && std::chrono::duration<double>(now - started).count() >= duration)
+            running.store(false);
+    }
+
+    input.stop();
+
+    sACNMetricsSnapshot snapshot = input.metrics()->snapshot();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double cpuSeconds = double(std::clock() - startCPU) / CLOCKS_PER_SEC;
+    Totals total(snapshot);
+
+    if(perUniverse)
+    {
+        // the handling time of the workers, by the share of the packets handled that belonged to the universe
+        double busySeconds = std::chrono::duration<double>(total.busy).count();
+        std::printf("%8s %12s %12s %10s %10s %8s %14s\n", "universe", "packets", "packets/s", "lost", "reordered", "sources",
+            "handling us/s");
+        for(const sACNUniverseMetricsSnapshot& universe : snapshot.universes)
+        {
+            std::printf("%8u %12llu %12.1f %10llu %10llu %8llu %14.2f\n",
+                universe.universe,
+                (unsigned long long)universe.packetsReceived,
+                universe.packetsReceived / elapsed,
+                (unsigned long long)universe.packetsLost,
+                (unsigned long long)universe.packetsDropped,
+                (unsigned long long)universe.sources,
+                total.handled == 0 ? 0.0 : 1e6 * busySeconds * universe.packetsReceived / total.handled / elapsed);
+        }
+    }
+
+    std::printf("Received %llu packets in %.1fs (%.0f packets/s), lost %llu, reordered %llu, invalid %llu, "
+        "cpu %.2fs (%.1f us per packet)\n",
+        (unsigned long long)total.received, elapsed, total.received / elapsed,
+        (unsigned long long)total.lost, (unsigned long long)total.reordered, (unsigned long long)total.invalid,
+        cpuSeconds, total.received == 0 ? 0.0 : 1e6 * cpuSeconds / total.received);
+    return 0;
+}
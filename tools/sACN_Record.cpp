@@ -0,0 +1,126 @@
+#include <sacn-cpp.hpp>
+#include <sacn_capture.hpp>
+#include "tool_options.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace sACNcpp;
+
+/**
+ * @brief Records everything a sACNInput receives on a range of universes to a capture file,
+ * to be played again with sACN_Replay.cpp.
+ */
+
+static std::atomic<bool> running{true};
+
+static void handleSignal(int)
+{
+    running.store(false);
+}
+
+static void usage()
+{
+    std::cout <<
+        "Usage: sacn-record --output PATH [options]\n"
+        "  --output PATH       the capture file to write\n"
+        "  --universes N       number of universes joined (default 1)\n"
+        "  --first U           first universe (default 1)\n"
+        "  --workers W         receive workers (default 1)\n"
+        "  --interface ADDR    the network interface to receive on\n"
+        "  --duration SECONDS  stop after SECONDS, 0 runs until interrupted (default 0)\n";
+}
+
+int main(int argc, char** argv)
+{
+    uint16_t universes, firstUniverse;
+    size_t receiveWorkers;
+    double duration;
+    std::string path, networkInterface;
+
+    try
+    {
+        tools::ToolOptions options(argc, argv);
+        if(options.has("help"))
+        {
+            usage();
+            return 0;
+        }
+
+        path = options.get("output", "");
+        universes = options.number("universes", 1);
+        firstUniverse = options.number("first", 1);
+        receiveWorkers = options.number("workers", 1);
+        networkInterface = options.get("interface", "");
+        duration = options.number("duration", 0);
+
+        if(path.empty())
+            throw std::invalid_argument("The capture file has to be given with --output.");
+        if(universes == 0 || firstUniverse == 0 || firstUniverse + universes - 1 > 63999)
+            throw std::invalid_argument("The universes have to be between 1 and 63999.");
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        usage();
+        return 1;
+    }
+
+    Logger::setLevel(LogLevel::Warning);
+
+    std::shared_ptr<sACNCaptureWriter> capture;
+    try
+    {
+        capture = std::make_shared<sACNCaptureWriter>(path);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    sACNInput input(nullptr, 64, receiveWorkers);
+    input.setCapture(capture);
+    if(!input.start(networkInterface))
+    {
+        std::cerr << "Could not open the receive sockets" << std::endl;
+        return 1;
+    }
+
+    for(uint16_t i = 0; i < universes; i++)
+    {
+        if(!input.addUniverse(firstUniverse + i))
+        {
+            std::cerr << "Could not join universe " << firstUniverse + i << std::endl;
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+    while(running.load())
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        std::printf("%8.1fs  %10llu packets  %8.1f MiB\n", elapsed,
+            (unsigned long long)capture->packets(), capture->bytes() / 1048576.0);
+        std::fflush(stdout);
+
+        if(duration > 0 && elapsed >= duration)
+            running.store(false);
+    }
+
+    input.stop();
+    capture->close();
+
+    std::cout << "Recorded " << capture->packets() << " packets to " << path << std::endl;
+    return 0;
+}
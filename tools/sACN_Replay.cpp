@@ -0,0 +1,113 @@
+#include <sacn_capture_player.hpp>
+#include "tool_options.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace sACNcpp;
+
+/**
+ * @brief Plays a capture file recorded with sACN_Record.cpp, with the original timing, faster or as fast as possible.
+ */
+
+static std::atomic<bool> running{true};
+static sACNCapturePlayer* player = nullptr;
+
+static void handleSignal(int)
+{
+    running.store(false);
+    if(player != nullptr)
+        player->stop();
+}
+
+static void usage()
+{
+    std::cout <<
+        "Usage: sacn-replay --input PATH [options]\n"
+        "  --input PATH        the capture file to play\n"
+        "  --speed FACTOR      playback speed, 0 plays as fast as possible (default 1)\n"
+        "  --loop N            number of times the capture is played, 0 repeats until interrupted (default 1)\n"
+        "  --unicast HOST      send to HOST instead of the multicast groups\n"
+        "  --interface ADDR    the network interface to send from\n";
+}
+
+int main(int argc, char** argv)
+{
+    double speed, loops;
+    std::string path, unicastHost, networkInterface;
+
+    try
+    {
+        tools::ToolOptions options(argc, argv);
+        if(options.has("help"))
+        {
+            usage();
+            return 0;
+        }
+
+        path = options.get("input", "");
+        speed = options.number("speed", 1);
+        loops = options.number("loop", 1);
+        unicastHost = options.get("unicast", "");
+        networkInterface = options.get("interface", "");
+
+        if(path.empty())
+            throw std::invalid_argument("The capture file has to be given with --input.");
+        if(speed < 0 || loops < 0)
+            throw std::invalid_argument("The speed and the number of loops have to be 0 or greater.");
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        usage();
+        return 1;
+    }
+
+    Logger::setLevel(LogLevel::Warning);
+
+    std::unique_ptr<sACNCapturePlayer> capturePlayer;
+    try
+    {
+        capturePlayer = std::make_unique<sACNCapturePlayer>(path);
+    }
+    catch(const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if(!capturePlayer->start(networkInterface))
+    {
+        std::cerr << "Could not open the socket" << std::endl;
+        return 1;
+    }
+
+    player = capturePlayer.get();
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    for(uint64_t loop = 0; (loops == 0 || loop < loops) && running.load(); loop++)
+    {
+        std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+        uint64_t sent;
+        try
+        {
+            sent = capturePlayer->play(speed, unicastHost);
+        }
+        catch(const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+        std::cout << "Sent " << sent << " packets in " << elapsed << "s (" << (elapsed > 0 ? sent / elapsed : 0)
+            << " packets/s)" << std::endl;
+    }
+
+    player = nullptr;
+    return 0;
+}
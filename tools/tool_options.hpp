@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace sACNcpp {
+namespace tools {
+
+/**
+ * @brief Parses command line arguments of the form "--name value" and "--flag" for the tools
+ *
+ */
+class ToolOptions
+{
+public:
+
+    /**
+     * @brief Parses the command line
+     *
+     * @throw std::invalid_argument if an argument does not start with "--"
+     * @param argc argc of main()
+     * @param argv argv of main()
+     */
+    ToolOptions(int argc, char** argv)
+    {
+        for(int i = 1; i < argc; i++)
+        {
+            std::string name = argv[i];
+            if(name.size() < 3 || name.compare(0, 2, "--") != 0)
+                throw std::invalid_argument("Unexpected argument " + name + ".");
+
+            name = name.substr(2);
+            if(i + 1 < argc && std::string(argv[i + 1]).compare(0, 2, "--") != 0)
+                m_values[name] = argv[++i];
+            else
+                m_values[name] = "";
+        }
+    }
+
+    /**
+     * @brief true if the option was given, with or without a value
+     *
+     */
+    bool has(const std::string& name) const
+    {
+        return m_values.count(name) > 0;
+    }
+
+    /**
+     * @brief the value of an option, or fallback if it was not given
+     *
+     */
+    std::string get(const std::string& name, const std::string& fallback) const
+    {
+        auto it = m_values.find(name);
+        return it == m_values.end() ? fallback : it->second;
+    }
+
+    /**
+     * @brief the numeric value of an option, or fallback if it was not given
+     *
+     * @throw std::invalid_argument if the value is not a number
+     */
+    double number(const std::string& name, double fallback) const
+    {
+        auto it = m_values.find(name);
+        if(it == m_values.end())
+            return fallback;
+
+        char* end = nullptr;
+        double value = std::strtod(it->second.c_str(), &end);
+        if(it->second.empty() || *end != '\0')
+            throw std::invalid_argument("The value of --" + name + " has to be a number.");
+        return value;
+    }
+
+private:
+
+    /**
+     * @brief the values by option name, empty for flags
+     *
+     */
+    std::map<std::string, std::string> m_values;
+};
+
+}
+}